@@ -0,0 +1,540 @@
+// Микробенчмарки горячих мест ядра. Все seed и позиции фиксированы, чтобы цифры
+// можно было сравнивать между коммитами. Перед замерами векторные ядра
+// сверяются со скалярными эталонами (отчёт в stderr); при расхождении замеры
+// не запускаются, а код возврата — 1.
+//
+//   lander_bench --benchmark_filter=ScanRadar
+//   lander_bench --verify-only
+#include "Config.h"
+#include "TerrainGenerator.h"
+#include "NoiseBatch.h"
+#include "ChunkedTerrain.h"
+#include "PhysicsEngine.h"
+#include "BatchPhysicsEngine.h"
+#include "LandingController.h"
+#include "LandingSiteDetector.h"
+#include "RadarTypes.h"
+#include "RaySegmentKernel.h"
+#include "HeightPyramid.h"
+#include "FixedRadar.h"
+#include "Simulation.h"
+#include "VecEnv.h"
+#include "WorkerPool.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <vector>
+
+static const int kSeed = 42;
+
+// Счётчик вызовов operator new: шаги, которые обещают обходиться без выделений,
+// проверяются по нему
+static std::atomic<long long> gAllocations{0};
+
+void* operator new(std::size_t size) {
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// Рельеф и пирамида по ширине окна, общие для всех бенчмарков радара
+struct BenchTerrain {
+    std::vector<float> heights;
+    HeightPyramid pyramid;
+
+    BenchTerrain() {
+        TerrainGenerator gen;
+        heights = gen.generate(Config::WINDOW_WIDTH, kSeed);
+        pyramid.build(heights);
+    }
+};
+
+static const BenchTerrain& benchTerrain() {
+    static const BenchTerrain t;
+    return t;
+}
+
+// Точка над серединой рельефа на заданной высоте над поверхностью (ось Y вниз)
+static Vec2 shipOrigin(const std::vector<float>& terrain, float altitude) {
+    float x = (float)terrain.size() * 0.5f;
+    return {x, terrain[(size_t)x] - altitude};
+}
+
+// range(0) — ширина, range(1) — потоков пула (0 — по числу ядер)
+static void BM_TerrainGenerate(benchmark::State& st) {
+    const int width = (int)st.range(0);
+    WorkerPool pool((int)st.range(1));
+    TerrainGenerator gen(&pool);
+    for (auto _ : st) {
+        auto t = gen.generate(width, kSeed);
+        benchmark::DoNotOptimize(t.data());
+    }
+    st.SetItemsProcessed(st.iterations() * width);
+}
+BENCHMARK(BM_TerrainGenerate)
+    ->ArgNames({"width", "threads"})
+    ->ArgsProduct({{1280, 20480, 1 << 20}, {1, 0}})
+    ->Unit(benchmark::kMicrosecond);
+
+// range(0) — радиус сильного сглаживания; время от него зависеть не должно
+static void BM_TerrainSmoothRadius(benchmark::State& st) {
+    const int width = 1 << 20;
+    WorkerPool pool(1);
+    TerrainGenerator gen(&pool);
+    gen.cfg.smoothRadius = (int)st.range(0);
+    for (auto _ : st) {
+        auto t = gen.generate(width, kSeed);
+        benchmark::DoNotOptimize(t.data());
+    }
+    st.SetItemsProcessed(st.iterations() * width);
+}
+BENCHMARK(BM_TerrainSmoothRadius)->Arg(6)->Arg(64)->Arg(1024)->Unit(benchmark::kMicrosecond);
+
+// Один кусок мира без краёв вместе с полями под сглаживание
+static void BM_TerrainGenerateChunk(benchmark::State& st) {
+    TerrainGenerator gen;
+    int index = 0;
+    for (auto _ : st) {
+        auto c = gen.generateChunk(kSeed, index++, ChunkedTerrain::CHUNK_WIDTH);
+        benchmark::DoNotOptimize(c.data());
+    }
+    st.SetItemsProcessed(st.iterations() * ChunkedTerrain::CHUNK_WIDTH);
+}
+BENCHMARK(BM_TerrainGenerateChunk)->Unit(benchmark::kMicrosecond);
+
+// range(0) — ядро шума (NoiseKernelIsa); 4096 точек вдоль x, как у рельефа
+static void BM_NoiseFbm(benchmark::State& st) {
+    NoiseFbmFn fn = noiseFbmKernelFor((NoiseKernelIsa)st.range(0));
+    if (!fn) {
+        st.SkipWithError("ISA not supported");
+        return;
+    }
+    st.SetLabel(noiseKernelIsaName((NoiseKernelIsa)st.range(0)));
+
+    const int n = 4096;
+    NoiseFbmConfig cfg;
+    cfg.seed = kSeed;
+    cfg.frequency = 0.002f;
+    cfg.gain = 0.4f;
+    std::vector<float> xs(n), ys(n, 0.0f), out(n);
+    for (int i = 0; i < n; ++i) xs[i] = (float)i;
+    for (auto _ : st) {
+        fn(cfg, xs.data(), ys.data(), out.data(), n);
+        benchmark::DoNotOptimize(out.data());
+    }
+    st.SetItemsProcessed(st.iterations() * n);
+}
+BENCHMARK(BM_NoiseFbm)
+    ->ArgName("isa")
+    ->Arg((int)NoiseKernelIsa::Scalar)
+    ->Arg((int)NoiseKernelIsa::Avx2);
+
+// range(0) — лучей, range(1) — высота над рельефом, range(2) — крен в миллирадианах
+static void BM_ScanRadar(benchmark::State& st) {
+    const BenchTerrain& bt = benchTerrain();
+    RadarConfig cfg;
+    cfg.rays = (int)st.range(0);
+    Vec2 origin = shipOrigin(bt.heights, (float)st.range(1));
+    float angle = (float)st.range(2) * 0.001f;
+
+    RadarHitBuffer hits;
+    for (auto _ : st) {
+        scanRadar(bt.heights, bt.pyramid, origin, angle, cfg, hits);
+        benchmark::DoNotOptimize(hits.t.data());
+    }
+    st.SetItemsProcessed(st.iterations() * cfg.rays);
+}
+BENCHMARK(BM_ScanRadar)
+    ->ArgNames({"rays", "alt", "mrad"})
+    ->ArgsProduct({{64, 157, 1024, 4096}, {20, 300}, {0, 600}});
+
+static void BM_ScanRadarBruteForce(benchmark::State& st) {
+    const BenchTerrain& bt = benchTerrain();
+    RadarConfig cfg;
+    cfg.rays = (int)st.range(0);
+    cfg.traversal = RadarTraversal::BruteForce;
+    Vec2 origin = shipOrigin(bt.heights, 300.0f);
+
+    RadarHitBuffer hits;
+    for (auto _ : st) {
+        scanRadar(bt.heights, origin, 0.0f, cfg, hits);
+        benchmark::DoNotOptimize(hits.t.data());
+    }
+    st.SetItemsProcessed(st.iterations() * cfg.rays);
+}
+BENCHMARK(BM_ScanRadarBruteForce)->ArgName("rays")->Arg(157)->Arg(1024);
+
+// Радар с памятью прошлого кадра: корабль смещается на шаг за итерацию
+static void BM_RadarScanner(benchmark::State& st) {
+    const BenchTerrain& bt = benchTerrain();
+    RadarConfig cfg = DefaultRadar::config();
+    Vec2 origin = shipOrigin(bt.heights, 150.0f);
+
+    RadarScanner scanner;
+    RadarHitBuffer hits;
+    int frame = 0;
+    for (auto _ : st) {
+        Vec2 o{origin.x + (float)(frame & 63) * 0.5f, origin.y};
+        scanner.scan(bt.heights, bt.pyramid, o, 0.0f, cfg, hits);
+        benchmark::DoNotOptimize(hits.t.data());
+        ++frame;
+    }
+    st.SetItemsProcessed(st.iterations() * cfg.rays);
+}
+BENCHMARK(BM_RadarScanner);
+
+static void BM_DetectLandingSites(benchmark::State& st) {
+    const BenchTerrain& bt = benchTerrain();
+    RadarConfig cfg;
+    cfg.rays = (int)st.range(0);
+    Vec2 origin = shipOrigin(bt.heights, 150.0f);
+
+    RadarHitBuffer hits;
+    scanRadar(bt.heights, bt.pyramid, origin, 0.0f, cfg, hits);
+
+    DetectorConfig det;
+    DetectorScratch scratch;
+    for (auto _ : st) {
+        const auto& sites = detectLandingSites(hits, origin.x, det, scratch);
+        benchmark::DoNotOptimize(sites.data());
+    }
+    st.SetItemsProcessed(st.iterations() * cfg.rays);
+}
+BENCHMARK(BM_DetectLandingSites)->ArgName("rays")->Arg(157)->Arg(1024);
+
+static void BM_PhysicsUpdate(benchmark::State& st) {
+    PhysicsEngine physics;
+    physics.setWind({3.0f, -1.0f});
+    const ControlOutput ctrl{0.6f, 0.2f, 0.1f, 0.05f, -0.05f};
+    const float ground = 1e9f; // касания не будет
+
+    int n = 0;
+    for (auto _ : st) {
+        // раз в 1024 шага заново с той же точки, чтобы состояние не уходило в бесконечность
+        if ((n++ & 1023) == 0) physics.init(640.0f, 50.0f, 500.0f, {100.0f, 100.0f});
+        physics.update(ctrl, ground);
+        benchmark::DoNotOptimize(physics);
+    }
+}
+BENCHMARK(BM_PhysicsUpdate);
+
+// Тот же шаг для range(0) аппаратов разом
+static void BM_BatchPhysicsUpdate(benchmark::State& st) {
+    const int n = (int)st.range(0);
+    BatchPhysicsEngine batch;
+    batch.resize(n);
+    batch.setWind({3.0f, -1.0f});
+    for (int i = 0; i < n; ++i) batch.setControl(i, {0.6f, 0.2f, 0.1f, 0.05f, -0.05f});
+    std::vector<float> ground((size_t)n, 1e9f);
+
+    int steps = 0;
+    for (auto _ : st) {
+        if ((steps++ & 1023) == 0) {
+            for (int i = 0; i < n; ++i) batch.init(i, 640.0f, 50.0f, 500.0f, {100.0f, 100.0f});
+        }
+        batch.update(ground.data());
+        benchmark::DoNotOptimize(batch.x.data());
+    }
+    st.SetItemsProcessed(st.iterations() * n);
+}
+BENCHMARK(BM_BatchPhysicsUpdate)->ArgName("landers")->Arg(1024)->Arg(16384);
+
+static void BM_LandingControllerCompute(benchmark::State& st) {
+    // Состояние и скан после сотни шагов автопилота над фиксированным рельефом
+    Simulation sim;
+    sim.reset(kSeed, 400.0f);
+    for (int i = 0; i < 100 && !sim.finished(); ++i) sim.step();
+    const RoverState state = sim.getState();
+    const RadarHitBuffer& hits = sim.getRadarHits();
+
+    LandingController controller;
+    if (sim.hasLandingTarget()) controller.setLandingTarget(sim.getLandingTarget());
+    for (auto _ : st) {
+        ControlOutput out = controller.compute(state, hits);
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BM_LandingControllerCompute);
+
+// Полный шаг как в окне: радар, детектор, автопилот, физика
+static void BM_SimulationStep(benchmark::State& st) {
+    Simulation sim;
+    sim.reset(kSeed, 400.0f);
+    for (auto _ : st) {
+        if (sim.finished()) {
+            st.PauseTiming();
+            sim.reset(kSeed, 400.0f);
+            st.ResumeTiming();
+        }
+        sim.step();
+    }
+    st.SetItemsProcessed(st.iterations());
+}
+BENCHMARK(BM_SimulationStep);
+
+// K сред за вызов, постоянное действие; закончившиеся сбрасываются сами
+static void BM_VecEnvStep(benchmark::State& st) {
+    const int k = (int)st.range(0);
+    VecEnv env(k);
+    std::vector<int> seeds((size_t)k);
+    for (int i = 0; i < k; ++i) seeds[i] = kSeed + i;
+
+    std::vector<float> obs((size_t)k * env.obsSize());
+    std::vector<float> actions((size_t)k * VecEnv::ACTION_SIZE, 0.0f);
+    std::vector<float> rewards((size_t)k);
+    std::vector<EnvDone> dones((size_t)k);
+    for (int i = 0; i < k; ++i) actions[(size_t)i * VecEnv::ACTION_SIZE] = 0.36f;
+
+    env.reset(seeds.data(), obs.data());
+    long long allocs = gAllocations.load();
+    for (auto _ : st) {
+        env.step(actions.data(), obs.data(), rewards.data(), dones.data());
+        benchmark::DoNotOptimize(obs.data());
+    }
+    st.SetItemsProcessed(st.iterations() * k);
+    // выделения дают только автосбросы (новый рельеф)
+    st.counters["allocs/step"] = benchmark::Counter((double)(gAllocations.load() - allocs) /
+                                                    (double)st.iterations());
+}
+BENCHMARK(BM_VecEnvStep)->ArgName("envs")->Arg(16)->Arg(256);
+
+// --- Сверка ядер с эталонами ---
+
+static bool checkReport(const char* what, const char* isa, int cases, int bad, double maxErr) {
+    std::fprintf(stderr, "check %-16s %-7s %6d cases  max err %.3g  %s\n",
+                 what, isa, cases, maxErr, bad ? "FAIL" : "ok");
+    if (bad) std::fprintf(stderr, "      %d mismatches\n", bad);
+    return bad == 0;
+}
+
+// Случайные лучи сверху вниз против пролётов рельефа в 1..64 столбца: индекс и t
+// векторного ядра против raySegmentsScalar. Индекс может разойтись, только если
+// t различаются (в пределах допуска); при равных t ядро обязано выбрать тот же
+// столбец, что и эталон
+static bool checkRayKernels() {
+    const std::vector<float>& h = benchTerrain().heights;
+    const float maxRange = 1200.0f;
+    bool ok = true;
+
+    const RayKernelIsa isas[] = {RayKernelIsa::Sse, RayKernelIsa::Avx2};
+    for (RayKernelIsa isa : isas) {
+        RaySegmentsFn fn = raySegmentsKernelFor(isa);
+        if (!fn) continue;
+
+        std::mt19937 rng(kSeed);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        int cases = 0, bad = 0;
+        double maxErr = 0.0;
+        for (int k = 0; k < 20000; ++k) {
+            int count = 1 + (int)(rng() % 64);
+            int x0 = (int)(rng() % (h.size() - 1 - (size_t)count));
+            float ground = h[(size_t)(x0 + count / 2)];
+            Vec2 O{(float)x0 + unit(rng) * (float)count, ground - 2.0f - 40.0f * unit(rng)};
+            float a = (unit(rng) - 0.5f) * 3.0f;    // от вертикали вниз
+            Vec2 D{std::sin(a), std::cos(a)};
+
+            float tRef = 0.0f, t = 0.0f;
+            int xRef = raySegmentsScalar(h.data(), x0, count, O, D, maxRange, tRef);
+            int x = fn(h.data(), x0, count, O, D, maxRange, t);
+            ++cases;
+            if (xRef < 0 || x < 0) {
+                if (x != xRef) ++bad;
+                continue;
+            }
+            double err = std::abs((double)t - tRef) / std::max(1.0, (double)tRef);
+            maxErr = std::max(maxErr, err);
+            if (err > kRayKernelTolerance || (x != xRef && t == tRef)) ++bad;
+        }
+        ok &= checkReport("ray segments", rayKernelIsaName(isa), cases, bad, maxErr);
+    }
+    return ok;
+}
+
+// Шум в точках рельефа и в случайных точках плоскости при нескольких
+// настройках фрактала против noiseFbmScalar, абсолютная разница до kNoiseKernelTolerance
+static bool checkNoiseKernels() {
+    const int n = 4099;     // не кратно восьми: хвост тоже проверяется
+    std::vector<NoiseFbmConfig> cfgs(3);
+    cfgs[0].seed = kSeed;
+    cfgs[0].frequency = 0.002f;
+    cfgs[0].gain = 0.4f;
+    cfgs[1].seed = -7;
+    cfgs[1].octaves = 5;
+    cfgs[1].weightedStrength = 0.6f;
+    cfgs[2].seed = 123456;
+    cfgs[2].frequency = 0.05f;
+    cfgs[2].octaves = 1;
+    bool ok = true;
+
+    const NoiseKernelIsa isas[] = {NoiseKernelIsa::Avx2};
+    for (NoiseKernelIsa isa : isas) {
+        NoiseFbmFn fn = noiseFbmKernelFor(isa);
+        if (!fn) continue;
+
+        std::mt19937 rng(kSeed);
+        std::uniform_real_distribution<float> coord(-1e5f, 1e5f);
+        std::vector<float> xs((size_t)n), ys((size_t)n), ref((size_t)n), out((size_t)n);
+        int cases = 0, bad = 0;
+        double maxErr = 0.0;
+        for (const NoiseFbmConfig& cfg : cfgs) {
+            for (int pass = 0; pass < 2; ++pass) {
+                for (int i = 0; i < n; ++i) {
+                    xs[i] = pass == 0 ? (float)i : coord(rng);
+                    ys[i] = pass == 0 ? 0.0f : coord(rng);
+                }
+                noiseFbmScalar(cfg, xs.data(), ys.data(), ref.data(), n);
+                fn(cfg, xs.data(), ys.data(), out.data(), n);
+                for (int i = 0; i < n; ++i) {
+                    double err = std::abs((double)out[i] - ref[i]);
+                    maxErr = std::max(maxErr, err);
+                    if (!(err <= kNoiseKernelTolerance)) ++bad;
+                }
+                cases += n;
+            }
+        }
+        ok &= checkReport("noise fbm", noiseKernelIsaName(isa), cases, bad, maxErr);
+    }
+    return ok;
+}
+
+static bool sameBits(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+static bool sameState(const RoverState& a, const RoverState& b) {
+    const float fa[] = {a.x, a.y, a.vx, a.vy, a.angle, a.angularVel, a.fuelMain, a.comXLocal,
+                        a.mainThrust, a.leftThrust, a.rightThrust, a.leftGimbal, a.rightGimbal,
+                        a.touchdownVx, a.touchdownVy};
+    const float fb[] = {b.x, b.y, b.vx, b.vy, b.angle, b.angularVel, b.fuelMain, b.comXLocal,
+                        b.mainThrust, b.leftThrust, b.rightThrust, b.leftGimbal, b.rightGimbal,
+                        b.touchdownVx, b.touchdownVy};
+    for (size_t k = 0; k < sizeof(fa) / sizeof(fa[0]); ++k) {
+        if (!sameBits(fa[k], fb[k])) return false;
+    }
+    if (a.crashed != b.crashed || a.landed != b.landed) return false;
+    if (a.auxTanks.size() != b.auxTanks.size()) return false;
+    for (size_t k = 0; k < a.auxTanks.size(); ++k) {
+        if (!sameBits(a.auxTanks[k], b.auxTanks[k])) return false;
+    }
+    return true;
+}
+
+// N аппаратов в BatchPhysicsEngine и столько же отдельных PhysicsEngine: разные
+// старты, баки, ветер и грунт, случайные команды на каждом шаге. После каждого
+// из K шагов состояния должны совпадать бит в бит (часть аппаратов за это
+// время садится или разбивается)
+static bool checkBatchPhysics() {
+    const int n = 37, steps = 900;
+    std::mt19937 rng(kSeed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    BatchPhysicsEngine batch;
+    batch.resize(n);
+    std::vector<PhysicsEngine> single((size_t)n);
+    std::vector<float> ground((size_t)n);
+    for (int i = 0; i < n; ++i) {
+        float x = 100.0f + 1000.0f * unit(rng);
+        float fuel = i % 5 == 0 ? 0.0f : 50.0f + 500.0f * unit(rng);
+        std::vector<float> aux;
+        for (int k = 0; k < i % 3; ++k) aux.push_back(100.0f * unit(rng));
+        Vec2 wind{6.0f * (unit(rng) - 0.5f), 2.0f * (unit(rng) - 0.5f)};
+
+        single[i].init(x, 50.0f, fuel, aux);
+        single[i].setWind(wind);
+        batch.init(i, x, 50.0f, fuel, aux);
+        batch.setWind(i, wind);
+        ground[i] = 150.0f + 400.0f * unit(rng);
+    }
+
+    int cases = 0, bad = 0;
+    for (int s = 0; s < steps; ++s) {
+        for (int i = 0; i < n; ++i) {
+            // чётные снижаются, тормозя у грунта, и садятся (кроме пустых баков);
+            // нечётные получают случайные команды чуть слабее зависания и разбиваются
+            float side = 0.1f * unit(rng);
+            ControlOutput c{0.2f + 0.2f * unit(rng), side, side + 0.02f * (unit(rng) - 0.5f),
+                            0.1f * (unit(rng) - 0.5f), 0.1f * (unit(rng) - 0.5f)};
+            if (i % 2 == 0) {
+                const RoverState& st = single[i].getState();
+                float alt = ground[i] - RoverBody::GROUND_OFFSET - st.y;
+                float vyTarget = -std::min(10.0f, std::max(1.0f, 0.3f * alt));   // vy вверх
+                float thrust = 0.37f - 0.1f * (st.vy - vyTarget);
+                c = {std::min(1.0f, std::max(0.0f, thrust)), 0.0f, 0.0f, 0.0f, 0.0f};
+            }
+            single[i].update(c, ground[i]);
+            batch.setControl(i, c);
+        }
+        batch.update(ground.data());
+        for (int i = 0; i < n; ++i) {
+            ++cases;
+            if (!sameState(single[i].getState(), batch.getState(i))) ++bad;
+        }
+    }
+    return checkReport("batch physics", "", cases, bad, 0.0);
+}
+
+// Шаг VecEnv без автосброса не выделяет память (сброс строит новый рельеф — ему
+// можно). Первые шаги прогревают буферы радара и детектора и не считаются
+static bool checkVecEnvAllocations() {
+    const int k = 16, warmup = 10, steps = 300;
+    VecEnv env(k);
+    std::vector<int> seeds((size_t)k);
+    for (int i = 0; i < k; ++i) seeds[i] = kSeed + i;
+    std::vector<float> obs((size_t)k * env.obsSize());
+    std::vector<float> actions((size_t)k * VecEnv::ACTION_SIZE, 0.0f);
+    std::vector<float> rewards((size_t)k);
+    std::vector<EnvDone> dones((size_t)k);
+    for (int i = 0; i < k; ++i) actions[(size_t)i * VecEnv::ACTION_SIZE] = 0.36f;
+
+    env.reset(seeds.data(), obs.data());
+    int cases = 0, bad = 0;
+    long long worst = 0;
+    for (int s = 0; s < warmup + steps; ++s) {
+        long long before = gAllocations.load();
+        env.step(actions.data(), obs.data(), rewards.data(), dones.data());
+        long long used = gAllocations.load() - before;
+        if (s < warmup) continue;
+        if (std::any_of(dones.begin(), dones.end(), [](EnvDone d) { return d != EnvDone::Running; })) continue;
+        ++cases;
+        worst = std::max(worst, used);
+        if (used) ++bad;
+    }
+    return checkReport("vecenv step allocs", "", cases, bad, (double)worst);
+}
+
+static bool verifyKernels() {
+    bool ok = true;
+    ok &= checkRayKernels();
+    ok &= checkNoiseKernels();
+    ok &= checkBatchPhysics();
+    ok &= checkVecEnvAllocations();
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    bool verifyOnly = false;
+    int kept = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--verify-only")) verifyOnly = true;
+        else argv[kept++] = argv[i];
+    }
+    argc = kept;
+
+    if (!verifyKernels()) return 1;
+    if (verifyOnly) return 0;
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
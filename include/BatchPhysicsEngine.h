@@ -0,0 +1,44 @@
+#pragma once
+#include "Config.h"
+#include <cstdint>
+#include <vector>
+
+// Физика для тысяч аппаратов сразу: состояние в виде структуры массивов, шаг —
+// векторизуемыми проходами. Для каждого аппарата результат бит в бит совпадает
+// с PhysicsEngine::update при тех же командах, ветре и высоте рельефа.
+class BatchPhysicsEngine {
+public:
+    // n аппаратов, у каждого до auxPerLander доп. баков; все сброшены и стоят в нуле
+    void resize(int n, int auxPerLander = 2);
+    int size() const { return count; }
+
+    void init(int i, float startX, float startY, float mainFuel, const std::vector<float>& aux);
+
+    void setWind(Vec2 w);          // всем
+    void setWind(int i, Vec2 w);   // одному
+    void setControl(int i, const ControlOutput& c);
+
+    // Шаг всех аппаратов; terrainHeight[i] — высота рельефа под i-м
+    void update(const float* terrainHeight);
+
+    RoverState getState(int i) const;
+
+    // Состояние, по полю на массив. Смысл полей тот же, что в RoverState
+    std::vector<float> x, y, vx, vy, angle, angularVel, fuelMain, comXLocal;
+    std::vector<float> mainThrust, leftThrust, rightThrust, leftGimbal, rightGimbal;
+    std::vector<float> touchdownVx, touchdownVy;
+    std::vector<uint8_t> crashed, landed;
+    std::vector<float> auxTanks;   // auxStride баков подряд на аппарат
+    std::vector<int> auxCount;
+
+    // Команды на следующий шаг и ветер
+    std::vector<float> cmdMain, cmdLeft, cmdRight, cmdLeftGimbal, cmdRightGimbal;
+    std::vector<float> windX, windY;
+
+private:
+    int count = 0;
+    int auxStride = 0;
+
+    // cos/sin на шаг: считаются скалярно той же libm, что и в PhysicsEngine
+    std::vector<float> cosAngle, sinAngle, cosLeft, sinLeft, cosRight, sinRight;
+};
@@ -0,0 +1,91 @@
+#pragma once
+#include "TerrainGenerator.h"
+#include "WorkerPool.h"
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Рельеф без краёв: куски по CHUNK_WIDTH столбцов генерируются по запросу из
+// seed и номера куска (TerrainGenerator::generateChunk). В памяти держится не
+// больше capacity кусков, вытесняется давно не нужный. Куски впереди корабля
+// заранее считает фоновый поток, так что при полёте запрос обычно попадает
+// в кэш. Поток заводится при первой предвыборке и считает куски сам, без
+// общего пула: фон не должен отнимать ядра у тех, кто ждёт ответа. В пакетных
+// прогонах предвыборку выключают — там миссии и так занимают все потоки.
+class ChunkedTerrain {
+public:
+    static constexpr int CHUNK_WIDTH = 1024;
+
+    using Chunk = std::shared_ptr<const std::vector<float>>;
+
+    struct Stats {
+        std::uint64_t hits = 0;         // кусок уже был в кэше
+        std::uint64_t misses = 0;       // пришлось считать на месте
+        std::uint64_t prefetched = 0;   // посчитан фоновым потоком
+        int resident = 0;
+    };
+
+    explicit ChunkedTerrain(int capacity = 32, bool prefetchEnabled = true);
+    ~ChunkedTerrain();
+
+    ChunkedTerrain(const ChunkedTerrain&) = delete;
+    ChunkedTerrain& operator=(const ChunkedTerrain&) = delete;
+
+    // Новый мир: кэш, очередь предвыборки и счётчики сбрасываются
+    void reset(int seed);
+
+    // Кусок из кэша или посчитанный сейчас. Если его как раз считает фоновый
+    // поток — дождаться его, а не считать второй раз
+    Chunk chunk(int index);
+
+    // Поставить куски в очередь фонового потока; уже готовые и те, что сейчас
+    // считаются, пропускаются. Без предвыборки ничего не делает
+    void prefetch(const int* indices, int count);
+
+    // Столбцы кусков [first, first + count) подряд
+    void assemble(int first, int count, std::vector<float>& out);
+
+    static int chunkOf(float x) { return (int)std::floor(x / (float)CHUNK_WIDTH); }
+
+    Stats stats() const;
+
+    // Менять только до reset: фоновый поток читает настройки без блокировки
+    TerrainConfig& terrainConfig() { return gen.cfg; }
+
+private:
+    struct Entry {
+        Chunk data;
+        std::list<int>::iterator lruPos;
+    };
+
+    TerrainGenerator gen;               // для chunk(): на пуле вызывающего
+    WorkerPool serial{1};               // без рабочих потоков: всё на месте
+    TerrainGenerator prefetchGen{&serial};  // только фоновый поток; cfg копируется из gen
+    int capacity;
+    bool prefetchEnabled;
+
+    mutable std::mutex m;
+    std::condition_variable wake;       // фоновому потоку: есть работа
+    std::condition_variable ready;      // ждущим chunk(): кусок посчитан
+    int seed = 0;
+    unsigned generation = 0;            // меняется в reset: результаты со старым seed не берём
+    std::unordered_map<int, Entry> cache;
+    std::list<int> lru;                 // спереди — самые свежие
+    std::deque<int> queue;
+    std::vector<int> inFlight;          // куски, которые сейчас считаются (chunk() или фон)
+    bool stopping = false;
+    std::thread worker;
+    Stats counters;
+
+    void insert(int index, Chunk data);     // под m
+    bool isInFlight(int index) const;       // под m
+    void finish(int index);                 // под m: кусок больше не считается
+    void prefetchLoop();
+};
@@ -1,5 +1,5 @@
 #pragma once
-#include <SFML/Graphics.hpp>
+#include <vector>
 
 // Константы физики и мира 
 namespace Config {
@@ -15,15 +15,14 @@ namespace Config {
 
     const float WIND_MAX = 30.0f;
     const float WIND_RATE = 10.0f;
-    
-    // Цвета
-    const sf::Color MARS_SKY_TOP(20, 20, 40);
-    const sf::Color MARS_SKY_BOTTOM(80, 40, 30);
-    const sf::Color TERRAIN_COLOR_TOP(200, 100, 50);
-    const sf::Color TERRAIN_COLOR_BOTTOM(50, 20, 10);
 }
 
 // Общие структуры данных
+struct Vec2 {
+    float x = 0.f;
+    float y = 0.f;
+};
+
 struct RoverState {
     float x, y;
     float vx, vy;
@@ -41,6 +40,9 @@ struct RoverState {
     float leftGimbal = 0.0f;
     float rightGimbal = 0.0f;
 
+    // Скорость в момент касания (после касания vx, vy обнуляются)
+    float touchdownVx = 0.0f;
+    float touchdownVy = 0.0f;
 };
 
 struct ControlOutput {
@@ -0,0 +1,76 @@
+#pragma once
+#include "RadarTypes.h"
+#include <array>
+
+// Радар с числом лучей и углом обзора, известными при компиляции. Направления
+// лучей в системе корабля считаются constexpr-таблицей, и за шаг остаётся один
+// поворот на угол корабля вместо cos/sin и нормировки на каждый луч.
+// Произвольные RadarConfig по-прежнему идут через обычный путь.
+namespace radar_detail {
+
+constexpr double kPi = 3.14159265358979323846;
+
+// std::sin/std::cos не constexpr в C++17 — ряд Тейлора после приведения к [-pi, pi]
+constexpr double wrapPi(double x) {
+    while (x > kPi)  x -= 2.0 * kPi;
+    while (x < -kPi) x += 2.0 * kPi;
+    return x;
+}
+
+constexpr double sinSeries(double x) {
+    x = wrapPi(x);
+    double term = x, sum = x;
+    for (int k = 1; k < 20; ++k) {
+        term *= -x * x / ((2.0 * k) * (2.0 * k + 1.0));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double cosSeries(double x) {
+    x = wrapPi(x);
+    double term = 1.0, sum = 1.0;
+    for (int k = 1; k < 20; ++k) {
+        term *= -x * x / ((2.0 * k - 1.0) * (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+} // namespace radar_detail
+
+template <int Rays, int FovMilliRad>
+class FixedRadar {
+    static_assert(Rays > 0, "radar needs at least one ray");
+
+public:
+    static constexpr int rays = Rays;
+    static constexpr float fovRad = FovMilliRad / 1000.0f;
+
+    // Луч i — это «вниз» (0, 1), повёрнутый на свой угол в секторе обзора;
+    // углы считаются так же, как в scanRadar
+    static constexpr std::array<Vec2, Rays> makeShipFrameDirs() {
+        std::array<Vec2, Rays> dirs{};
+        for (int i = 0; i < Rays; ++i) {
+            float a = (Rays == 1) ? 0.f : (float)i / (float)(Rays - 1);
+            float ang = (-0.5f * fovRad) + a * fovRad;
+            dirs[i].x = (float)-radar_detail::sinSeries(ang);
+            dirs[i].y = (float)radar_detail::cosSeries(ang);
+        }
+        return dirs;
+    }
+
+    static constexpr std::array<Vec2, Rays> shipFrameDirs = makeShipFrameDirs();
+
+    // Конфиг со ссылкой на таблицу; дальность и ширину скана можно менять
+    static RadarConfig config(RadarConfig base = {}) {
+        base.rays = Rays;
+        base.fovRad = fovRad;
+        base.shipFrameDirs = shipFrameDirs.data();
+        base.shipFrameDirCount = Rays;
+        return base;
+    }
+};
+
+// Конфигурация по умолчанию из RadarConfig
+using DefaultRadar = FixedRadar<157, 2000>;
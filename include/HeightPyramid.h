@@ -0,0 +1,32 @@
+#pragma once
+#include <vector>
+
+// Иерархия min/max над рельефом: уровень k хранит блоки по 2^k отрезков,
+// отрезок x соединяет вершины terrain[x] и terrain[x + 1].
+// Ось Y направлена вниз, поэтому minY — самая высокая точка блока.
+class HeightPyramid {
+public:
+    void build(const std::vector<float>& terrain);
+    void clear();
+
+    bool empty() const { return minLevels.empty(); }
+    int segments() const { return empty() ? 0 : (int)minLevels[0].size(); }
+    int levels() const { return (int)minLevels.size(); }
+
+    // Блок block уровня level покрывает отрезки [block << level, ((block + 1) << level) - 1]
+    float blockMinY(int level, int block) const { return minLevels[level][block]; }
+    float blockMaxY(int level, int block) const { return maxLevels[level][block]; }
+
+    // Экстремумы по отрезкам [x0, x1] за O(log n); диапазон обрезается по рельефу.
+    // Пустой диапазон (и пустая пирамида): minY = +inf, maxY = -inf
+    float minY(int x0, int x1) const;
+    float maxY(int x0, int x1) const;
+
+private:
+    std::vector<std::vector<float>> minLevels;
+    std::vector<std::vector<float>> maxLevels;
+
+    template <typename Pick>
+    float rangeQuery(const std::vector<std::vector<float>>& lv, int x0, int x1,
+                     float identity, Pick pick) const;
+};
@@ -5,7 +5,7 @@
 
 class LandingController {
 public:
-    ControlOutput compute(const RoverState& state, const std::vector<RayHit>& radarHits);
+    ControlOutput compute(const RoverState& state, const RadarHitBuffer& radarHits);
 
     // Сохраняем найденную площадку
     void setLandingTarget(const LandingSite& site);
@@ -33,6 +33,7 @@ private:
 
     bool targetLocked = false;
     LandingSite lockedSite{};
+    DetectorScratch detScratch;
 
     void resetPids() { 
         integralAlt = 0.0f; 
@@ -12,15 +12,34 @@ struct LandingSite {
     float score = 0.f;
 };
 
+// tan(Config::MAX_LANDING_ANGLE_RAD) — допуск по высоте площадки по умолчанию
+float defaultMaxBandY();
+
 struct DetectorConfig {
     float maxGapX = 10.f;       // максимальный разрыв между точками
     float minLenX = 40.f;       // минимальная длина площадки
     float maxSlope = 0.05f;     // ограничение на кривизну поверхности
-    float maxBandY = std::tan(Config::MAX_LANDING_ANGLE_RAD);      // ограничение на угол наклона площадки
+    float maxBandY = defaultMaxBandY();     // ограничение на угол наклона площадки
 };
 
 std::vector<LandingSite> detectLandingSites(const std::vector<RayHit>& hits,
                                             float roverX,
                                             const DetectorConfig& cfg);
 
+std::vector<LandingSite> detectLandingSites(const RadarHitBuffer& hits,
+                                            float roverX,
+                                            const DetectorConfig& cfg);
+
+// Память детектора у вызывающего: после первых вызовов ничего не выделяется
+struct DetectorScratch {
+    std::vector<int> order;             // номера попаданий в hits по возрастанию x
+    std::vector<LandingSite> sites;
+};
+
+// То же без копирования точек: сортируются номера лучей. Результат — в scratch.sites
+const std::vector<LandingSite>& detectLandingSites(const RadarHitBuffer& hits,
+                                                   float roverX,
+                                                   const DetectorConfig& cfg,
+                                                   DetectorScratch& scratch);
+
 bool pickBestSite(const std::vector<LandingSite>& sites, LandingSite& outBest);
@@ -0,0 +1,42 @@
+#pragma once
+
+// Пакетный 2D-шум OpenSimplex2 с фракталом FBm — то подмножество
+// FastNoiseLite, на котором стоит рельеф. Настройки и значения по умолчанию
+// те же, что у FastNoiseLite.
+struct NoiseFbmConfig {
+    int seed = 1337;
+    float frequency = 0.01f;
+    int octaves = 3;
+    float lacunarity = 2.0f;
+    float gain = 0.5f;
+    float weightedStrength = 0.0f;
+};
+
+// out[i] = FastNoiseLite::GetNoise(xs[i], ys[i]) при тех же настройках
+using NoiseFbmFn = void (*)(const NoiseFbmConfig& cfg, const float* xs, const float* ys,
+                            float* out, int n);
+
+enum class NoiseKernelIsa { Scalar, Avx2 };
+
+// AVX2-версия повторяет скалярную формулу операция в операцию (без FMA), по
+// восемь точек за раз, так что на x86 значения совпадают побитно. Допуск на
+// случай, если компилятор всё же сольёт умножение со сложением:
+constexpr float kNoiseKernelTolerance = 1e-5f; // абсолютная, шум в [-1, 1]
+
+// Эталон: цикл по FastNoiseLite::GetNoise
+void noiseFbmScalar(const NoiseFbmConfig& cfg, const float* xs, const float* ys,
+                    float* out, int n);
+
+// Лучшее ядро для текущего процессора (определяется один раз)
+NoiseFbmFn noiseFbmKernel();
+NoiseKernelIsa noiseFbmKernelIsa();
+const char* noiseKernelIsaName(NoiseKernelIsa isa);
+
+// Конкретное ядро или nullptr, если процессор его не поддерживает
+NoiseFbmFn noiseFbmKernelFor(NoiseKernelIsa isa);
+
+inline void noiseFbmBatch(const NoiseFbmConfig& cfg, const float* xs, const float* ys,
+                          float* out, int n)
+{
+    noiseFbmKernel()(cfg, xs, ys, out, n);
+}
@@ -2,16 +2,32 @@
 #include "Config.h"
 #include <vector>
 
+// Параметры корпуса, общие для PhysicsEngine и BatchPhysicsEngine
+namespace RoverBody {
+    constexpr float MASS = 10.0f;
+    constexpr float GROUND_OFFSET = 20.0f;  // от центра до опор
+    constexpr float WIDTH = 20.0f;
+    constexpr float HEIGHT = 16.0f;
+    constexpr float MAX_COM_SHIFT = 1.2f;   // смещение центра масс по корпусу
+    constexpr float COM_TAU = 0.65f;
+    constexpr float LINEAR_DRAG_X = 0.35f;
+    constexpr float LINEAR_DRAG_Y = 0.10f;
+    constexpr float ANGULAR_DAMPING = 0.90f;
+    constexpr float FUEL_TRANSFER = 5.0f;   // за шаг из доп. бака
+    constexpr float FUEL_TRANSFER_BELOW = 100.0f;
+}
+
 class PhysicsEngine {
 public:
     void init(float startX, float startY, float mainFuel, const std::vector<float>& aux);
     void update(ControlOutput input, float terrainHeight);
-    RoverState getState() const;
+    // По ссылке: копия тянула бы за собой выделение под auxTanks на каждом шаге
+    const RoverState& getState() const { return state; }
 
-    void setWind(sf::Vector2f w);
-    sf::Vector2f getWind() const { return windForce; }
+    void setWind(Vec2 w);
+    Vec2 getWind() const { return windForce; }
 
 private:
     RoverState state;
-    sf::Vector2f windForce{0.0f, 0.0f};
+    Vec2 windForce{0.0f, 0.0f};
 };
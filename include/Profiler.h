@@ -0,0 +1,94 @@
+#pragma once
+#include "Trace.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Этапы, которые меряются пробами ProfileScope
+enum class ProfileStage : std::uint8_t {
+    SimStep,        // весь шаг Simulation
+    RadarScan,
+    DetectSites,
+    Controller,
+    Physics,
+    TerrainGen,     // рельеф и пирамида при reset
+    Frame,          // кадр окна целиком
+    DrawBackground,
+    DrawRadar,
+    DrawLander,
+    DrawHud,
+    Count
+};
+
+constexpr int PROFILE_STAGE_COUNT = (int)ProfileStage::Count;
+
+struct ProfileStageStats {
+    float meanUs = 0.0f;
+    float p99Us = 0.0f;
+    float maxUs = 0.0f;
+    int samples = 0;
+};
+
+struct ProfileReport {
+    ProfileStageStats stages[PROFILE_STAGE_COUNT];
+};
+
+// Лёгкий профилировщик этапов: на каждый этап кольцо из последних WINDOW
+// замеров. Запись без блокировок и из любого потока; выключенная проба стоит
+// одну relaxed-загрузку флага.
+namespace Profiler {
+    constexpr int WINDOW = 256;
+
+    extern std::atomic<bool> enabledFlag;
+
+    inline bool enabled() { return enabledFlag.load(std::memory_order_relaxed); }
+    // Включение сбрасывает накопленные замеры
+    void setEnabled(bool on);
+
+    void record(ProfileStage stage, std::int64_t ns);
+
+    // Среднее, p99 и максимум по окну — для оверлея, не для горячего пути
+    ProfileReport report();
+
+    const char* stageName(ProfileStage stage);
+    // Этап внутри SimStep или Frame — в оверлее с отступом
+    bool stageNested(ProfileStage stage);
+    // "sim" или "render" — категория в трассе
+    const char* stageCategory(ProfileStage stage);
+}
+
+// Замер области видимости: идёт в статистику оверлея и/или в трассу (Trace).
+// Решение «мерить или нет» принимается на входе.
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileStage s)
+        : stage(s), toStats(Profiler::enabled()), toTrace(Trace::enabled()), active(toStats || toTrace)
+    {
+        if (active) start = std::chrono::steady_clock::now();
+    }
+    ~ProfileScope() { finish(); }
+
+    // Закрыть текущий этап и тут же начать следующий — для цепочки этапов в одной функции
+    void restart(ProfileStage next) {
+        finish();
+        stage = next;
+        if (active) start = std::chrono::steady_clock::now();
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileStage stage;
+    bool toStats;
+    bool toTrace;
+    bool active;
+    std::chrono::steady_clock::time_point start;
+
+    void finish() {
+        if (!active) return;
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        if (toStats) Profiler::record(stage, ns);
+        if (toTrace) Trace::complete(Profiler::stageName(stage), Profiler::stageCategory(stage), start, ns);
+    }
+};
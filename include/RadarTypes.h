@@ -1,10 +1,9 @@
 #pragma once
 #include <vector>
+#include <cstdint>
+#include "Config.h"
 
-struct Vec2 {
-    float x = 0.f;
-    float y = 0.f;
-};
+class HeightPyramid;
 
 struct RayHit {
     Vec2 origin;
@@ -15,14 +14,94 @@ struct RayHit {
     int segIndex = -1;
 };
 
+// Результат скана структурой массивов: i-й элемент каждого массива — i-й луч.
+// Для промаха point — конец луча на maxRange, t == maxRange, segIndex == -1.
+// Буфер принадлежит вызывающему и переиспользуется между шагами без выделений.
+struct RadarHitBuffer {
+    Vec2 origin;
+    std::vector<float> t;
+    std::vector<float> px, py;
+    std::vector<int> segIndex;
+    std::vector<std::uint8_t> hit;
+
+    int size() const { return (int)t.size(); }
+    void resize(int n);
+};
+
+// Способ обхода рельефа лучом
+enum class RadarTraversal {
+    BruteForce,  // эталон: каждый луч против всех отрезков в [xMin, xMax]
+    Heightfield  // проход по столбцам вдоль луча до первого пересечения
+};
+
 struct RadarConfig {
     int rays = 157;
     float fovRad = 2.0f;
     float maxRange = 1200.f;
     float maxXSpan = 1200.f;
+    RadarTraversal traversal = RadarTraversal::Heightfield;
+
+    // Готовые единичные направления лучей в системе корабля, см. FixedRadar.
+    // Если заданы, fovRad не используется, а за шаг остаётся один поворот на угол корабля.
+    // Таблица берётся, только если в ней ровно rays направлений; иначе (скажем,
+    // rays поменяли после FixedRadar::config) направления считаются из fovRad.
+    const Vec2* shipFrameDirs = nullptr;
+    int shipFrameDirCount = 0;
+
+    // С этого числа лучей скан делится между потоками общего WorkerPool;
+    // на меньших сканах накладные расходы дороже выигрыша. 0 — всегда в одном потоке.
+    int parallelMinRays = 1024;
 };
 
 std::vector<RayHit> scanRadar(const std::vector<float>& terrain,
                               Vec2 origin,
                               float shipAngleRad,
                               const RadarConfig& cfg);
+
+// То же, но пустые блоки рельефа пропускаются по пирамиде min/max
+std::vector<RayHit> scanRadar(const std::vector<float>& terrain,
+                              const HeightPyramid& pyramid,
+                              Vec2 origin,
+                              float shipAngleRad,
+                              const RadarConfig& cfg);
+
+// Те же сканы в буфер вызывающего
+void scanRadar(const std::vector<float>& terrain,
+               Vec2 origin,
+               float shipAngleRad,
+               const RadarConfig& cfg,
+               RadarHitBuffer& out);
+
+void scanRadar(const std::vector<float>& terrain,
+               const HeightPyramid& pyramid,
+               Vec2 origin,
+               float shipAngleRad,
+               const RadarConfig& cfg,
+               RadarHitBuffer& out);
+
+// Радар с памятью между шагами: для каждого луча хранится отрезок прошлого
+// попадания, и поиск начинается с окна вокруг него. При 30 Гц корабль почти не
+// смещается, так что обычно хватает нескольких отрезков. Результат совпадает с scanRadar.
+class RadarScanner {
+public:
+    std::vector<RayHit> scan(const std::vector<float>& terrain,
+                             const HeightPyramid& pyramid,
+                             Vec2 origin,
+                             float shipAngleRad,
+                             const RadarConfig& cfg);
+
+    void scan(const std::vector<float>& terrain,
+              const HeightPyramid& pyramid,
+              Vec2 origin,
+              float shipAngleRad,
+              const RadarConfig& cfg,
+              RadarHitBuffer& out);
+
+    // Забыть прошлые попадания (новый рельеф)
+    void reset();
+
+private:
+    std::vector<int> seeds;
+
+    int* seedsFor(const RadarConfig& cfg);
+};
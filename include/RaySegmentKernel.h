@@ -0,0 +1,29 @@
+#pragma once
+#include "RadarTypes.h"
+
+// Ядро пересечения одного луча с подряд идущими отрезками рельефа.
+// Отрезок x соединяет (x, terrain[x]) и (x + 1, terrain[x + 1]).
+// Возвращает индекс ближайшего отрезка (при равных t — меньший) или -1, t пишется в outT.
+using RaySegmentsFn = int (*)(const float* terrain, int x0, int count,
+                              Vec2 O, Vec2 D, float maxRange, float& outT);
+
+enum class RayKernelIsa { Scalar, Sse, Avx2 };
+
+// Векторные версии повторяют скалярную формулу операция в операцию (без FMA),
+// поэтому на x86 t совпадает побитно. Допуск на случай, если компилятор
+// всё же сольёт умножение со сложением:
+constexpr float kRayKernelTolerance = 1e-4f; // относительная погрешность t
+
+int raySegmentsScalar(const float* terrain, int x0, int count,
+                      Vec2 O, Vec2 D, float maxRange, float& outT);
+
+// Лучшее ядро для текущего процессора (определяется один раз)
+RaySegmentsFn raySegmentsKernel();
+RayKernelIsa raySegmentsKernelIsa();
+const char* rayKernelIsaName(RayKernelIsa isa);
+
+// Полос в векторе ядра: 1, 4 или 8
+int rayKernelLanes(RayKernelIsa isa);
+
+// Конкретное ядро или nullptr, если процессор его не поддерживает
+RaySegmentsFn raySegmentsKernelFor(RayKernelIsa isa);
@@ -0,0 +1,137 @@
+#pragma once
+#include "Config.h"
+#include "Simulation.h"
+#include "SpscQueue.h"
+#include "TripleBuffer.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Нажатия из окна, которые разбирает поток симуляции
+enum class SimCommand : std::uint8_t {
+    TogglePause,
+    Restart,
+    ToggleAuto,
+    ResetWind,
+    SlowDown,
+    SpeedUp,
+    SwapGimbals,
+    ZeroGimbals,
+    GimbalLeft,
+    GimbalRight,
+    GimbalBoth,
+    ToggleTurbo,
+    ToggleUnbounded     // мир без краёв и обратно; сразу новая миссия
+};
+
+// Удерживаемые клавиши: окно опрашивает клавиатуру и кладёт маску целиком
+namespace HeldKey {
+    enum : std::uint32_t {
+        MainThrust  = 1u << 0,   // Up
+        LeftThrust  = 1u << 1,   // Left
+        RightThrust = 1u << 2,   // Right
+        GimbalUp    = 1u << 3,   // W
+        GimbalDown  = 1u << 4,   // S
+        GimbalQ     = 1u << 5,
+        GimbalE     = 1u << 6,
+        WindUp      = 1u << 7,   // U
+        WindDown    = 1u << 8,   // J
+        WindLeft    = 1u << 9,   // H
+        WindRight   = 1u << 10   // K
+    };
+}
+
+// Всё, что нужно окну для одного кадра
+struct SimSnapshot {
+    RoverState state{};
+    std::vector<float> terrain;     // окно рельефа, terrain[i] — столбец terrainOrigin + i
+    int terrainOrigin = 0;
+    unsigned terrainVersion = 0;    // рельеф копируется, только когда сменился
+    bool unbounded = false;         // мир без краёв: камера идёт за кораблём
+    RadarHitBuffer radarHits;
+    bool hasTargetSite = false;
+    LandingSite targetSite{};
+    const char* phaseName = "";
+
+    bool autoMode = true;
+    bool paused = true;
+    float foundMsgTimer = 0.0f;
+    Vec2 wind{0.0f, 0.0f};
+    float timeScale = 1.0f;
+    int gimbalMode = 3;
+
+    bool turbo = false;
+    float stepsPerSecond = 0.0f;    // фактическая скорость симуляции
+};
+
+// Симуляция в своём потоке с фиксированной частотой 1/DT. После каждого тика
+// снимок уходит в тройной буфер, окно берёт последний готовый. Команды идут
+// обратно через SPSC-очередь, удерживаемые клавиши — атомарной маской.
+// В турбо-режиме шаги идут без пауз, а снимок публикуется с частотой экрана.
+// Снимок публикуется, только если что-то поменялось: на паузе окно может спать.
+class SimThread {
+public:
+    SimThread();        // первая миссия и первый снимок готовы ещё до запуска
+    ~SimThread();
+
+    SimThread(const SimThread&) = delete;
+    SimThread& operator=(const SimThread&) = delete;
+
+    void start();
+    void stop();
+
+    // --- поток окна ---
+    bool send(SimCommand cmd) { return commands.push(cmd); }
+    void setHeldKeys(std::uint32_t mask) { heldKeys.store(mask, std::memory_order_relaxed); }
+
+    // Забирает последний опубликованный снимок; true, если он новый
+    bool refresh() { return snapshots.update(); }
+    // Ссылка живёт до следующего refresh()
+    const SimSnapshot& snapshot() const { return snapshots.front(); }
+
+    static constexpr int TURBO_PUBLISH_HZ = 60;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Simulation sim;
+    TripleBuffer<SimSnapshot> snapshots;
+    SpscQueue<SimCommand, 64> commands;
+    std::atomic<std::uint32_t> heldKeys{0};
+    std::atomic<bool> running{false};
+    std::thread worker;
+
+    // дальше — только поток симуляции
+    bool autoMode = true;
+    bool paused = true;
+    float timeScale = 1.0f;
+    float timeAcc = 0.0f;
+    int gimbalMode = 3;         // 1=левый,2=правый,3=оба
+    float leftGimbal = 0.0f;
+    float rightGimbal = 0.0f;
+    bool landingFoundShown = false;
+    float foundMsgTimer = 0.0f;
+    Vec2 wind{0.0f, 0.0f};
+    bool turbo = false;
+    bool dirty = true;              // есть что публиковать
+    bool pausedScanValid = false;   // скан на паузе уже сделан для этого положения
+
+    long long stepsDone = 0;
+    long long rateSteps = 0;
+    Clock::time_point rateStart{};
+    float stepsPerSecond = 0.0f;
+
+    void run();
+    std::uint32_t pollInput();
+    void tick();
+    void turboBurst(Clock::time_point until);
+    void measureRate();
+    void publish();
+    void restartMission();
+    void apply(SimCommand cmd);
+    bool updateWind(std::uint32_t keys);
+    void stepOnce(std::uint32_t keys);
+    ControlOutput manualControl(std::uint32_t keys);
+};
@@ -0,0 +1,92 @@
+#pragma once
+#include "Config.h"
+#include "TerrainGenerator.h"
+#include "ChunkedTerrain.h"
+#include "PhysicsEngine.h"
+#include "LandingController.h"
+#include "LandingSiteDetector.h"
+#include "RadarTypes.h"
+#include "HeightPyramid.h"
+#include <memory>
+#include <vector>
+
+// Одна миссия без окна: рельеф, физика, радар, детектор и автопилот.
+// На ней стоят и окно (через SimThread), и пакетный прогон.
+class Simulation {
+public:
+    Simulation();
+
+    // Новый рельеф из seed и старт с высоты 50 над точкой startX
+    void reset(int seed, float startX);
+
+    void setWind(Vec2 w) { wind = w; }
+    Vec2 getWind() const { return wind; }
+
+    // Шаг с автопилотом
+    void step();
+    // Шаг с ручным управлением (радар и поиск площадки всё равно работают)
+    void step(const ControlOutput& manual);
+
+    // Скан из текущего положения с заданным углом, без шага и без памяти радара
+    void scanRadarAt(float shipAngleRad);
+
+    const RoverState& getState() const { return state; }
+    bool finished() const { return state.landed || state.crashed; }
+    int stepCount() const { return steps; }
+
+    // Рельеф вокруг корабля: getTerrain()[i] — высота в столбце terrainOrigin() + i.
+    // В мире с краями это весь рельеф и terrainOrigin() == 0
+    const std::vector<float>& getTerrain() const { return terrain; }
+    const HeightPyramid& getPyramid() const { return pyramid; }
+    int terrainOrigin() const { return terrainX0; }
+    // Меняется с каждым новым рельефом и с каждым сдвигом окна
+    unsigned terrainVersion() const { return terrainVer; }
+    // Высота грунта под мировым x (за краем окна — крайний столбец)
+    float groundAt(float x) const;
+    // Кэш кусков мира без краёв или nullptr
+    const ChunkedTerrain* chunkedTerrain() const { return world.get(); }
+    const RadarHitBuffer& getRadarHits() const { return radarHits; }
+
+    bool hasLandingTarget() const { return autopilot.hasLandingTarget(); }
+    const LandingSite& getLandingTarget() const { return autopilot.getLandingTarget(); }
+    const char* getPhaseName() const { return autopilot.getPhaseName(); }
+
+    RadarConfig radarCfg;
+    DetectorConfig detCfg;
+
+    // Мир без краёв: рельеф берётся кусками из ChunkedTerrain, а вокруг корабля
+    // держится окно из WINDOW_CHUNKS кусков. Радар, физика и окно приложения
+    // работают с окном; оно сдвигается, когда корабль уходит от его середины.
+    // Читается в reset
+    bool unboundedTerrain = false;
+    // Фоновая предвыборка кусков впереди корабля. Пакетным прогонам она не
+    // нужна: миссии занимают все потоки, а куски всё равно считаются по промаху.
+    // Читается при создании кэша кусков (первый reset без краёв)
+    bool terrainPrefetch = true;
+    static constexpr int WINDOW_CHUNKS = 5;
+
+private:
+    TerrainGenerator terrainGen;
+    PhysicsEngine physics;
+    LandingController autopilot;
+    RadarScanner radar;
+
+    std::unique_ptr<ChunkedTerrain> world;    // только в мире без краёв
+    std::vector<float> terrain;
+    HeightPyramid pyramid;
+    int terrainX0 = 0;
+    unsigned terrainVer = 0;
+    RadarHitBuffer radarHits;
+    DetectorScratch detScratch;
+
+    RoverState state{};
+    Vec2 wind{0.0f, 0.0f};
+    int steps = 0;
+
+    void advance(const ControlOutput* manual);
+    // Окно из кусков [first, first + WINDOW_CHUNKS); dir — куда летим (0 — неизвестно)
+    void moveWindow(int first, int dir);
+    void followRover();
+    // Скан в координатах окна; попадания переводятся обратно в мировые
+    void scanWindow(float shipAngleRad, bool tracked);
+};
@@ -0,0 +1,35 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// Кольцевая очередь фиксированной ёмкости для одного производителя и одного
+// потребителя, без блокировок и выделений памяти. Переполненная очередь не ждёт:
+// push возвращает false.
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // --- поток производителя ---
+    bool push(const T& v) {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == Capacity) return false;
+        items[h & (Capacity - 1)] = v;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // --- поток потребителя ---
+    bool pop(T& out) {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) return false;
+        out = items[t & (Capacity - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    alignas(64) std::atomic<std::size_t> head{0};  // следующая запись
+    alignas(64) std::atomic<std::size_t> tail{0};  // следующее чтение
+    T items[Capacity];
+};
@@ -2,7 +2,40 @@
 #include "Config.h"
 #include <vector>
 
+class WorkerPool;
+
+// Сглаживание рельефа: проходы скользящего среднего по 2*radius+1 точкам.
+// Цена прохода от radius не зависит, так что широкие окна на больших картах
+// ничего не стоят. Края шириной radius остаются как есть.
+struct TerrainConfig {
+    int fineRadius = 2;     // до зон посадки, снимает мелкую дробь
+    int finePasses = 1;
+    int smoothRadius = 6;   // после зон, скругляет их края
+    int smoothPasses = 2;
+};
+
+// Рельеф по seed. Ширина режется на куски по CHUNK столбцов, и шум и каждый
+// проход сглаживания считаются кусками на пуле потоков. Каждый столбец
+// считается тем же выражением в том же порядке, так что результат побитово
+// один и тот же при любом числе потоков (бегущая сумма сглаживания заводится
+// заново с начала каждого CHUNK, а не с начала куска пула). Зоны посадки
+// берут числа из своего генератора, заведённого от seed, а не из глобального
+// std::rand, поэтому генерировать рельефы можно одновременно из разных потоков.
 class TerrainGenerator {
 public:
+    static constexpr int CHUNK = 1 << 14;
+
+    // pool == nullptr — общий WorkerPool::shared()
+    explicit TerrainGenerator(WorkerPool* pool = nullptr) : pool(pool) {}
+
     std::vector<float> generate(int width, int seed);
+
+    // Кусок бесконечного рельефа: столбцы [index * width, (index + 1) * width).
+    // Соседние куски стыкуются без шва, площадки у каждого куска свои
+    std::vector<float> generateChunk(int seed, int index, int width);
+
+    TerrainConfig cfg;
+
+private:
+    WorkerPool* pool;
 };
@@ -0,0 +1,37 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Запись событий в формате Chrome trace (chrome://tracing, ui.perfetto.dev).
+// У каждого потока своё кольцо на RING_EVENTS событий: пишет только владелец,
+// без блокировок; при переполнении затираются самые старые. Кольцо заводится
+// при первом событии потока и живёт до конца процесса, так что трассу можно
+// сохранить и после того, как поток завершился.
+namespace Trace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int RING_EVENTS = 1 << 16;
+
+    extern std::atomic<bool> enabledFlag;
+
+    inline bool enabled() { return enabledFlag.load(std::memory_order_relaxed); }
+
+    // start() очищает кольца и ставит начало отсчёта времени. stop() выключает
+    // запись и ждёт, пока допишутся события, начатые до него; события, которые
+    // приходят позже (скажем, закрытие замера, открытого до stop), отбрасываются
+    void start();
+    void stop();
+
+    // Имя текущего потока в трассе ("sim", "render", ...); ничего не выделяет
+    void setThreadName(const char* name);
+
+    // name и category — строки со статическим временем жизни
+    void complete(const char* name, const char* category, Clock::time_point begin, std::int64_t durNs);
+    void instant(const char* name, const char* category);
+
+    // Сохранить всё записанное как JSON. Звать только после stop(): пока запись
+    // идёт, владельцы колец пишут в те же слоты, что читаются здесь
+    bool writeJson(const std::string& path);
+}
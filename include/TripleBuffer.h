@@ -0,0 +1,42 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Тройной буфер без блокировок для одного писателя и одного читателя.
+// Писатель заполняет back() и вызывает publish(); читатель вызывает update() и
+// читает front(). Слоты не копируются: стороны лишь обмениваются индексами
+// через средний слот, так что ни одна из них никогда не ждёт другую.
+template <typename T>
+class TripleBuffer {
+public:
+    // --- поток писателя ---
+    T& back() { return slots[backIdx].value; }
+
+    void publish() {
+        std::uint8_t prev = middle.exchange(std::uint8_t(backIdx | FRESH), std::memory_order_acq_rel);
+        backIdx = prev & INDEX;
+    }
+
+    // --- поток читателя ---
+    // true, если с прошлого вызова появился новый снимок
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        std::uint8_t prev = middle.exchange(frontIdx, std::memory_order_acq_rel);
+        frontIdx = prev & INDEX;
+        return true;
+    }
+
+    const T& front() const { return slots[frontIdx].value; }
+
+private:
+    static constexpr std::uint8_t INDEX = 3;
+    static constexpr std::uint8_t FRESH = 4;
+
+    // слоты на разных кэш-линиях, чтобы писатель и читатель не делили их
+    struct alignas(64) Slot { T value{}; };
+    Slot slots[3];
+
+    std::atomic<std::uint8_t> middle{1};
+    std::uint8_t backIdx = 0;   // принадлежит писателю
+    std::uint8_t frontIdx = 2;  // принадлежит читателю
+};
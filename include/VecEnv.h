@@ -0,0 +1,75 @@
+#pragma once
+#include "Config.h"
+#include "Simulation.h"
+#include <cstdint>
+#include <vector>
+
+// Исход шага для каждой среды
+enum class EnvDone : uint8_t { Running = 0, Landed = 1, Crashed = 2, Timeout = 3 };
+
+struct VecEnvConfig {
+    int maxSteps = 180 * 30;        // 3 минуты при 30 Гц, дальше Timeout
+    int radarSamples = 16;          // лучей радара в наблюдении, равномерно по вееру
+    float startXMin = 100.0f;
+    float startXMax = (float)Config::WINDOW_WIDTH - 100.0f;
+    float windMax = 0.0f;           // постоянный ветер миссии, модуль по осям до windMax
+
+    float landReward = 100.0f;
+    float crashReward = -100.0f;
+    float fuelCost = 0.01f;         // штраф за единицу сожжённого топлива
+};
+
+// K миссий под одним вызовом: reset(seeds) и step(actions) пишут наблюдения,
+// награды и исходы в непрерывные буферы вызывающего, без выделений памяти на шаге.
+// Закончившаяся миссия тут же перезапускается, и в obs попадает уже первое
+// наблюдение новой миссии. Seed следующего эпизода выводится из seed, данного
+// среде в reset, и номера эпизода, так что среды не повторяют миссии друг друга
+// при любых seeds.
+//
+// Действие — ACTION_SIZE чисел на среду в порядке ControlOutput.
+// Наблюдение — obsSize() чисел на среду:
+//   0  высота над рельефом под аппаратом     6  есть ли цель посадки (0/1)
+//   1  vx                                    7  dx до центра цели
+//   2  vy                                    8  высота цели над аппаратом
+//   3  угол                                  9  ветер x
+//   4  угловая скорость                     10  ветер y
+//   5  доля оставшегося топлива             11… дальности radarSamples лучей / maxRange (1 — нет попадания)
+class VecEnv {
+public:
+    static constexpr int ACTION_SIZE = 5;
+    static constexpr int STATE_OBS = 11;
+
+    explicit VecEnv(int numEnvs, const VecEnvConfig& cfg = {});
+
+    int size() const { return (int)envs.size(); }
+    int obsSize() const { return STATE_OBS + cfg.radarSamples; }
+
+    // seeds[K]; obs[K * obsSize()]
+    void reset(const int* seeds, float* obs);
+
+    // actions[K * ACTION_SIZE]; obs[K * obsSize()], rewards[K], dones[K]
+    void step(const float* actions, float* obs, float* rewards, EnvDone* dones);
+
+    const Simulation& env(int i) const { return envs[i].sim; }
+    int seed(int i) const { return envs[i].seed; }          // seed текущего эпизода
+    int episode(int i) const { return envs[i].episode; }    // 0 — эпизод из reset
+
+private:
+    struct Env {
+        Simulation sim;
+        int baseSeed = 0;           // из reset
+        int episode = 0;
+        int seed = 0;
+        float fuelStart = 0.0f;
+        float fuel = 0.0f;          // топливо на прошлом шаге
+        float reward = 0.0f;
+        EnvDone done = EnvDone::Running;
+    };
+
+    VecEnvConfig cfg;
+    std::vector<Env> envs;
+
+    void resetEnv(Env& e, int seed);
+    void stepEnv(Env& e, const float* action);
+    void writeObs(const Env& e, float* out) const;
+};
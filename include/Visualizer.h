@@ -3,35 +3,112 @@
 #include "Config.h"
 #include "RadarTypes.h"
 #include "LandingSiteDetector.h"
+#include "Profiler.h"
+#include <string>
 #include <vector>
 
+// Цвета живут здесь: ядро симуляции от SFML не зависит
+namespace Config {
+    const sf::Color MARS_SKY_TOP(20, 20, 40);
+    const sf::Color MARS_SKY_BOTTOM(80, 40, 30);
+    const sf::Color TERRAIN_COLOR_TOP(200, 100, 50);
+    const sf::Color TERRAIN_COLOR_BOTTOM(50, 20, 10);
+}
+
 class Visualizer {
 public:
-    Visualizer();
+    Visualizer();   // окно уже создано: небо и звёзды сразу уходят в видеопамять
+
+    // Новый рельеф: грунт пересобирается и загружается один раз на миссию
+    // (в мире без краёв — ещё и при сдвиге окна). terrain[i] — столбец originX + i
+    void setTerrain(const std::vector<float>& terrain, int originX = 0);
+
+    // Мировой x левого края экрана: небо, звёзды и HUD стоят, остальное сдвигается
+    void setCameraX(float x) { cameraX = x; }
 
     void draw(sf::RenderWindow& window, const RoverState& state, 
-              const std::vector<float>& terrain, 
-              const std::vector<RayHit>& radarHits,
+              const RadarHitBuffer& radarHits,
               bool hasTargetSite,
               const LandingSite& targetSite,
               bool autoMode, bool paused,
               float foundMsgTimer,
               sf::Vector2f wind,
               float timeScale,
+              bool turbo,
+              float stepsPerSecond,
               int gimbalMode,
               const char* phaseName); 
 
+    // Сколько полей HUD пришлось пересобрать в последнем кадре
+    int hudRelayoutCount() const { return hudRelayouts; }
+
+    // Оверлей профилировщика: среднее, p99 и максимум по этапам, в экранных координатах
+    void drawProfiler(sf::RenderWindow& window, const ProfileReport& report);
+
 private:
+    // Неизменная между миссиями геометрия: вершины собираются один раз и лежат в
+    // статическом VertexBuffer; без поддержки VBO рисуется тот же массив вершин.
+    struct StaticMesh {
+        sf::PrimitiveType type;
+        std::vector<sf::Vertex> vertices;
+        sf::VertexBuffer buffer;
+        bool onGpu = false;
+
+        explicit StaticMesh(sf::PrimitiveType t) : type(t), buffer(t, sf::VertexBuffer::Usage::Static) {}
+        void upload();
+        void draw(sf::RenderTarget& target) const;
+    };
+
     sf::Font font;
+    float cameraX = 0.0f;
     std::vector<sf::Vector2f> stars;
     std::vector<sf::Vector2f> windStreaks;
 
+    StaticMesh sky{sf::PrimitiveType::TriangleStrip};
+    StaticMesh starPoints{sf::PrimitiveType::Points};
+    StaticMesh ground{sf::PrimitiveType::TriangleStrip};
+
+    // Лучи и отметки попаданий радара: по одному вызову отрисовки на кадр,
+    // массивы переиспользуются и после первого кадра не выделяют память
+    sf::VertexArray radarRays{sf::PrimitiveType::Lines};
+    sf::VertexArray radarMarks{sf::PrimitiveType::Triangles};
+
+    // Строка HUD: sf::Text живёт между кадрами, а глифы раскладываются заново,
+    // только когда меняется показанный текст (то есть значение с точностью показа)
+    struct HudField {
+        sf::Text text;
+        std::string shown;
+
+        HudField(const sf::Font& font, unsigned size, sf::Color color) : text(font, "", size) {
+            text.setFillColor(color);
+        }
+        // true, если текст пришлось обновить
+        bool set(const char* value);
+    };
+
+    enum HudLine {
+        HudStatus, HudPhase, HudMode, HudAngle, HudPos, HudVel, HudFuel, HudTime, HudWind,
+        HudGimbal, HudSiteHeader, HudSite, HudSiteDist, HudSiteAlt,
+        HUD_LINE_COUNT
+    };
+
+    std::vector<HudField> hud;
+    std::vector<HudField> profLines;    // заголовок, этапы, счётчик HUD
+    sf::RectangleShape profPanel;
+    HudField foundMsg;
+    sf::Text pausedText;
+    sf::RectangleShape hudPanel;
+    float hudLineHeight = 17.f;
+    int hudRelayouts = 0;
+
     void drawHUD(sf::RenderWindow& window,
                  const RoverState& state,
                  bool autoMode,
                  bool paused,
                  sf::Vector2f wind,
                  float timeScale,
+                 bool turbo,
+                 float stepsPerSecond,
                  int gimbalMode,
                  const char* phaseName,
                  bool hasTargetSite,
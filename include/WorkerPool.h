@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Постоянный пул потоков для параллельных циклов. parallelFor режет [0, n) на
+// непрерывные куски, вызывающий поток работает наравне с остальными и
+// возвращается, когда всё готово. Вызов изнутри задачи пула выполняется
+// последовательно в том же потоке, так что вложенные циклы безопасны.
+// Исключение из тела цикла (в любом потоке) дожидается остальных исполнителей
+// и пробрасывается из parallelFor; если их несколько — первое.
+class WorkerPool {
+public:
+    // threads — общее число исполнителей вместе с вызывающим; 0 — по числу ядер
+    explicit WorkerPool(int threads = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int size() const { return (int)workers.size() + 1; }
+
+    // fn(begin, end) для кусков не короче minChunk (кроме последнего).
+    // fn передаётся по ссылке без std::function: вызов ничего не выделяет
+    template <class Fn>
+    void parallelFor(int n, int minChunk, Fn&& fn) {
+        using F = std::remove_reference_t<Fn>;
+        run(n, minChunk, ChunkFn{(void*)std::addressof(fn),
+                                 [](void* f, int begin, int end) { (*static_cast<F*>(f))(begin, end); }});
+    }
+
+    // Общий пул процесса, создаётся при первом обращении
+    static WorkerPool& shared();
+
+private:
+    // Ссылка на тело цикла: указатель на объект и функция вызова
+    struct ChunkFn {
+        void* ctx;
+        void (*call)(void*, int, int);
+        void operator()(int begin, int end) const { call(ctx, begin, end); }
+    };
+
+    std::vector<std::thread> workers;
+
+    std::mutex submitMutex;          // одна задача за раз
+    std::mutex m;
+    std::condition_variable wake;
+    std::condition_variable finished;
+
+    const ChunkFn* job = nullptr;
+    int jobSize = 0;
+    int chunk = 1;
+    std::atomic<int> nextIndex{0};
+    int busy = 0;                    // исполнители, ещё не закончившие текущую задачу
+    unsigned generation = 0;
+    bool stopping = false;
+    std::exception_ptr error;        // первое исключение текущей задачи
+
+    void workerLoop();
+    void run(int n, int minChunk, ChunkFn fn);
+    void runChunks(const ChunkFn& fn, int n, int chunkSize);
+};
@@ -0,0 +1,106 @@
+/* C-интерфейс симулятора (libmarslander). Только C-типы, без исключений через
+ * границу: ошибки — отрицательные коды ML_ERR_*, ml_create при ошибке даёт NULL.
+ * Пакетные вызовы ml_*_many обрабатывают n симуляций за один переход через FFI
+ * и шагают их параллельно на общем пуле потоков. Сбой одной симуляции не
+ * прерывает остальные: в status[i] (если status не NULL) пишется код каждой,
+ * а сам вызов возвращает ML_ERR_INTERNAL, если хоть одна не удалась.
+ *
+ * Симуляция не потокобезопасна: один ml_sim не трогают из двух потоков сразу. */
+#ifndef MARSLANDER_H
+#define MARSLANDER_H
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+    #if defined(MARSLANDER_BUILD)
+        #define ML_API __declspec(dllexport)
+    #else
+        #define ML_API __declspec(dllimport)
+    #endif
+#else
+    #define ML_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Версия ABI: растёт при любом несовместимом изменении структур и сигнатур */
+#define ML_ABI_VERSION 2
+
+#define ML_OK 0
+#define ML_ERR_ARG (-1)       /* NULL или размер вне допустимого */
+#define ML_ERR_INTERNAL (-2)  /* исключение внутри симулятора */
+
+typedef struct ml_sim ml_sim;
+
+/* Команды двигателям, как ControlOutput: тяга 0..1, углы подвеса в радианах */
+typedef struct ml_control {
+    float main_thrust;
+    float left_thrust;
+    float right_thrust;
+    float left_gimbal;
+    float right_gimbal;
+} ml_control;
+
+/* Ось Y направлена вниз, как в окне */
+typedef struct ml_state {
+    float x, y;
+    float vx, vy;
+    float angle;
+    float angular_vel;
+    float fuel_main;
+    float fuel_aux;            /* сумма доп. баков */
+    float touchdown_vx, touchdown_vy;
+    int32_t landed;
+    int32_t crashed;
+    int32_t steps;
+} ml_state;
+
+ML_API int ml_abi_version(void);
+
+/* Новый рельеф из seed, старт на высоте 50 над startX */
+ML_API ml_sim* ml_create(int seed, float start_x);
+ML_API void ml_destroy(ml_sim* sim);
+ML_API int ml_reset(ml_sim* sim, int seed, float start_x);
+
+ML_API int ml_set_wind(ml_sim* sim, float wind_x, float wind_y);
+
+/* Шаг 1/30 с. control == NULL — управляет встроенный автопилот */
+ML_API int ml_step(ml_sim* sim, const ml_control* control);
+ML_API int ml_get_state(const ml_sim* sim, ml_state* out);
+
+/* Высоты рельефа по колонкам. Возвращает ширину; пишет не больше capacity значений */
+ML_API int ml_get_terrain(const ml_sim* sim, float* out, int capacity);
+
+/* Выбранная автопилотом площадка: 1 — есть, 0 — нет */
+ML_API int ml_get_landing_target(const ml_sim* sim, float* center_x, float* y_mean);
+
+/* Скан радара из текущего положения с углом angle, без шага.
+ * Любой из out_* может быть NULL. Возвращает число лучей; пишет не больше capacity */
+ML_API int ml_radar_scan(ml_sim* sim, float angle,
+                         float* out_t, float* out_px, float* out_py, uint8_t* out_hit,
+                         int capacity);
+
+/* Пакетные версии. status — n кодов или NULL */
+ML_API int ml_reset_many(ml_sim* const* sims, int n, const int32_t* seeds, const float* start_x,
+                         int32_t* status);
+
+/* controls — n команд или NULL (автопилот у всех) */
+ML_API int ml_step_many(ml_sim* const* sims, int n, const ml_control* controls,
+                        int32_t* status);
+
+/* angles — n углов. Симуляция i пишет в out_*[i * capacity ...], status[i] —
+ * число лучей или код ошибки */
+ML_API int ml_radar_scan_many(ml_sim* const* sims, int n, const float* angles,
+                              float* out_t, float* out_px, float* out_py, uint8_t* out_hit,
+                              int capacity, int32_t* status);
+
+ML_API int ml_get_state_many(ml_sim* const* sims, int n, ml_state* out);
+ML_API int ml_set_wind_many(ml_sim* const* sims, int n, const float* wind_xy);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
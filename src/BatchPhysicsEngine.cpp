@@ -0,0 +1,433 @@
+#include "BatchPhysicsEngine.h"
+#include "PhysicsEngine.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define LANDER_BATCH_SSE 1
+    #include <emmintrin.h>
+#else
+    #define LANDER_BATCH_SSE 0
+#endif
+
+// Константы шага, как в PhysicsEngine::update
+static const float kDt = Config::DT;
+static const float kMass = RoverBody::MASS;
+static const float kW = RoverBody::WIDTH;
+static const float kH = RoverBody::HEIGHT;
+static const float kInertia = (1.0f / 12.0f) * kMass * (kW*kW + kH*kH);
+static const float kMaxComShift = RoverBody::MAX_COM_SHIFT;
+static const float kComRate = std::min(1.0f, kDt / std::max(1e-3f, RoverBody::COM_TAU));
+
+// Массивы батча на время одного update
+struct BatchLanes {
+    float *x, *y, *vx, *vy, *angle, *angularVel, *fuelMain, *comXLocal;
+    float *mainThrust, *leftThrust, *rightThrust, *leftGimbal, *rightGimbal;
+    float *touchdownVx, *touchdownVy;
+    uint8_t *crashed, *landed;
+    const float *cmdMain, *cmdLeft, *cmdRight, *cmdLeftGimbal, *cmdRightGimbal;
+    const float *windX, *windY;
+    const float *cosAngle, *sinAngle, *cosLeft, *sinLeft, *cosRight, *sinRight;
+    const float* terrain;
+};
+
+// Один аппарат: тело PhysicsEngine::update после перекачки топлива, с готовыми cos/sin.
+// Для хвоста батча и платформ без SSE2
+static void stepLane(const BatchLanes& L, int i) {
+    if (L.crashed[i] || L.landed[i]) return;
+
+    const float dt = kDt;
+    const float mass = kMass;
+    const float groundoffset = RoverBody::GROUND_OFFSET;
+    const float w = kW;
+    const float h = kH;
+    const float maxComShift = kMaxComShift;
+
+    float c = L.cosAngle[i];
+    float s = L.sinAngle[i];
+    float g_xL = s * Config::GRAVITY;
+
+    float comTarget = std::clamp((-g_xL / Config::GRAVITY) * maxComShift, -maxComShift, +maxComShift);
+    float com = L.comXLocal[i];
+    com += (comTarget - com) * kComRate;
+    L.comXLocal[i] = std::clamp(com, -maxComShift, +maxComShift);
+
+    float mainN  = std::clamp(L.cmdMain[i], 0.0f, 1.0f) * Config::MAX_MAIN_THRUST;
+    float leftN  = std::clamp(L.cmdLeft[i], 0.0f, 1.0f) * Config::MAX_SIDE_THRUST;
+    float rightN = std::clamp(L.cmdRight[i], 0.0f, 1.0f) * Config::MAX_SIDE_THRUST;
+
+    float consumption = (mainN * 0.05f + (leftN + rightN) * 0.05f) * dt;
+    L.fuelMain[i] = std::max(0.0f, L.fuelMain[i] - consumption);
+    if (L.fuelMain[i] <= 0.0f) {
+        mainN = 0.0f; leftN = 0.0f; rightN = 0.0f;
+    }
+
+    float Fm_xL = 0.0f;
+    float Fm_yL = mainN;
+    float Fl_xL = leftN * L.cosLeft[i];
+    float Fl_yL = leftN * L.sinLeft[i];
+    float Fr_xL = -rightN * L.cosRight[i];
+    float Fr_yL = rightN * L.sinRight[i];
+
+    float F_xL = Fm_xL + Fl_xL + Fr_xL;
+    float F_yL = Fm_yL + Fl_yL + Fr_yL;
+
+    float F_x = F_xL * c + F_yL * s;
+    float F_y = -F_xL * s + F_yL * c;
+
+    float ax = (F_x / mass);
+    float ay = (F_y / mass) - Config::GRAVITY;
+
+    ax += (L.windX[i] / mass);
+    ay += (-L.windY[i] / mass);
+
+    ax += -RoverBody::LINEAR_DRAG_X * L.vx[i];
+    ay += -RoverBody::LINEAR_DRAG_Y * L.vy[i];
+
+    float vx = L.vx[i] + ax * dt;
+    float vy = L.vy[i] + ay * dt;
+    float x = L.x[i] + vx * dt;
+    float y = L.y[i] - vy * dt;
+
+    float rL_xL = -w * 0.5f, rL_yL = 0.0f;
+    float rR_xL = +w * 0.5f, rR_yL = 0.0f;
+
+    float rL_x = rL_xL * c + rL_yL * s;
+    float rL_y = -rL_xL * s + rL_yL * c;
+    float rR_x = rR_xL * c + rR_yL * s;
+    float rR_y = -rR_xL * s + rR_yL * c;
+
+    float rM_xL = 0.0f - L.comXLocal[i], rM_yL = -h * 0.5f;
+    float rM_x = rM_xL * c + rM_yL * s;
+    float rM_y = -rM_xL * s + rM_yL * c;
+
+    float Fm_x = Fm_xL * c + Fm_yL * s;
+    float Fm_y = -Fm_xL * s + Fm_yL * c;
+
+    float Fl_x = Fl_xL * c + Fl_yL * s;
+    float Fl_y = -Fl_xL * s + Fl_yL * c;
+    float Fr_x = Fr_xL * c + Fr_yL * s;
+    float Fr_y = -Fr_xL * s + Fr_yL * c;
+
+    float tau = (rL_x * Fl_y - rL_y * Fl_x) +
+                (rR_x * Fr_y - rR_y * Fr_x) +
+                (rM_x * Fm_y - rM_y * Fm_x);
+    float alpha = tau / kInertia;
+
+    float wv = L.angularVel[i] + alpha * dt;
+    wv *= RoverBody::ANGULAR_DAMPING;
+    float ang = L.angle[i] + wv * dt;
+
+    // Проверка посадки
+    float ground = L.terrain[i] - groundoffset;
+    if (y >= ground) {
+        y = ground;
+
+        bool safeSpeed = std::abs(vy) < 2.0f && std::abs(vx) < 12.0f;
+        bool bothLegsDown = std::abs(ang) < Config::MAX_LANDING_ANGLE_RAD;
+
+        if (safeSpeed && bothLegsDown) L.landed[i] = 1;
+        else L.crashed[i] = 1;
+
+        L.touchdownVx[i] = vx;
+        L.touchdownVy[i] = vy;
+
+        vx = 0; vy = 0; wv = 0;
+    }
+
+    L.x[i] = x; L.y[i] = y;
+    L.vx[i] = vx; L.vy[i] = vy;
+    L.angle[i] = ang; L.angularVel[i] = wv;
+
+    L.mainThrust[i] = L.cmdMain[i];
+    L.leftThrust[i] = L.cmdLeft[i];
+    L.rightThrust[i] = L.cmdRight[i];
+    L.leftGimbal[i] = L.cmdLeftGimbal[i];
+    L.rightGimbal[i] = L.cmdRightGimbal[i];
+}
+
+#if LANDER_BATCH_SSE
+
+// Четыре аппарата за раз. Те же операции в том же порядке, что в stepLane, ветки
+// заменены масками. std::clamp(v, lo, hi) == min(hi, max(lo, v)) в смысле minps/maxps,
+// включая NaN, так что результат совпадает бит в бит. Если собирать с FMA (-march=native),
+// скалярный код сольёт умножения со сложениями — тогда нужен -ffp-contract=off
+static void stepLanesSse(const BatchLanes& L, int i) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 dt = _mm_set1_ps(kDt);
+    const __m128 mass = _mm_set1_ps(kMass);
+    const __m128 gravity = _mm_set1_ps(Config::GRAVITY);
+    const __m128 comMax = _mm_set1_ps(+kMaxComShift);
+    const __m128 comMin = _mm_set1_ps(-kMaxComShift);
+    auto neg = [&](__m128 v) { return _mm_xor_ps(v, signMask); };
+    auto clamp = [](__m128 v, __m128 lo, __m128 hi) { return _mm_min_ps(hi, _mm_max_ps(lo, v)); };
+    auto select = [](__m128 m, __m128 a, __m128 b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); };
+
+    // живые: ни упавшие, ни севшие
+    const __m128i flags = _mm_setr_epi32(L.crashed[i]   | L.landed[i],
+                                         L.crashed[i+1] | L.landed[i+1],
+                                         L.crashed[i+2] | L.landed[i+2],
+                                         L.crashed[i+3] | L.landed[i+3]);
+    const __m128 live = _mm_castsi128_ps(_mm_cmpeq_epi32(flags, _mm_setzero_si128()));
+    if (_mm_movemask_ps(live) == 0) return;
+
+    const __m128 c = _mm_loadu_ps(L.cosAngle + i);
+    const __m128 s = _mm_loadu_ps(L.sinAngle + i);
+    __m128 g_xL = _mm_mul_ps(s, gravity);
+
+    __m128 comTarget = clamp(_mm_mul_ps(_mm_div_ps(neg(g_xL), gravity), comMax), comMin, comMax);
+    const __m128 com0 = _mm_loadu_ps(L.comXLocal + i);
+    __m128 com = _mm_add_ps(com0, _mm_mul_ps(_mm_sub_ps(comTarget, com0), _mm_set1_ps(kComRate)));
+    com = clamp(com, comMin, comMax);
+
+    const __m128 cmdMain = _mm_loadu_ps(L.cmdMain + i);
+    const __m128 cmdLeft = _mm_loadu_ps(L.cmdLeft + i);
+    const __m128 cmdRight = _mm_loadu_ps(L.cmdRight + i);
+    __m128 mainN  = _mm_mul_ps(clamp(cmdMain, zero, one), _mm_set1_ps(Config::MAX_MAIN_THRUST));
+    __m128 leftN  = _mm_mul_ps(clamp(cmdLeft, zero, one), _mm_set1_ps(Config::MAX_SIDE_THRUST));
+    __m128 rightN = _mm_mul_ps(clamp(cmdRight, zero, one), _mm_set1_ps(Config::MAX_SIDE_THRUST));
+
+    const __m128 k005 = _mm_set1_ps(0.05f);
+    __m128 consumption = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(mainN, k005),
+                                               _mm_mul_ps(_mm_add_ps(leftN, rightN), k005)), dt);
+    const __m128 fuel0 = _mm_loadu_ps(L.fuelMain + i);
+    __m128 fuel = _mm_max_ps(_mm_sub_ps(fuel0, consumption), zero);
+    const __m128 hasFuel = _mm_cmpgt_ps(fuel, zero);  // !(fuel <= 0): после max NaN уже нет
+    mainN  = _mm_and_ps(hasFuel, mainN);
+    leftN  = _mm_and_ps(hasFuel, leftN);
+    rightN = _mm_and_ps(hasFuel, rightN);
+
+    __m128 Fm_xL = zero;
+    __m128 Fm_yL = mainN;
+    __m128 Fl_xL = _mm_mul_ps(leftN, _mm_loadu_ps(L.cosLeft + i));
+    __m128 Fl_yL = _mm_mul_ps(leftN, _mm_loadu_ps(L.sinLeft + i));
+    __m128 Fr_xL = _mm_mul_ps(neg(rightN), _mm_loadu_ps(L.cosRight + i));
+    __m128 Fr_yL = _mm_mul_ps(rightN, _mm_loadu_ps(L.sinRight + i));
+
+    __m128 F_xL = _mm_add_ps(_mm_add_ps(Fm_xL, Fl_xL), Fr_xL);
+    __m128 F_yL = _mm_add_ps(_mm_add_ps(Fm_yL, Fl_yL), Fr_yL);
+
+    __m128 F_x = _mm_add_ps(_mm_mul_ps(F_xL, c), _mm_mul_ps(F_yL, s));
+    __m128 F_y = _mm_add_ps(_mm_mul_ps(neg(F_xL), s), _mm_mul_ps(F_yL, c));
+
+    __m128 ax = _mm_div_ps(F_x, mass);
+    __m128 ay = _mm_sub_ps(_mm_div_ps(F_y, mass), gravity);
+
+    ax = _mm_add_ps(ax, _mm_div_ps(_mm_loadu_ps(L.windX + i), mass));
+    ay = _mm_add_ps(ay, _mm_div_ps(neg(_mm_loadu_ps(L.windY + i)), mass));
+
+    const __m128 vx0 = _mm_loadu_ps(L.vx + i);
+    const __m128 vy0 = _mm_loadu_ps(L.vy + i);
+    ax = _mm_add_ps(ax, _mm_mul_ps(_mm_set1_ps(-RoverBody::LINEAR_DRAG_X), vx0));
+    ay = _mm_add_ps(ay, _mm_mul_ps(_mm_set1_ps(-RoverBody::LINEAR_DRAG_Y), vy0));
+
+    __m128 vx = _mm_add_ps(vx0, _mm_mul_ps(ax, dt));
+    __m128 vy = _mm_add_ps(vy0, _mm_mul_ps(ay, dt));
+    const __m128 x0 = _mm_loadu_ps(L.x + i);
+    const __m128 y0 = _mm_loadu_ps(L.y + i);
+    __m128 x = _mm_add_ps(x0, _mm_mul_ps(vx, dt));
+    __m128 y = _mm_sub_ps(y0, _mm_mul_ps(vy, dt));
+
+    // нулевые rL_yL, rR_yL умножаются честно, как и в скалярном коде
+    const __m128 rL_xL = _mm_set1_ps(-kW * 0.5f), rL_yL = zero;
+    const __m128 rR_xL = _mm_set1_ps(+kW * 0.5f), rR_yL = zero;
+
+    __m128 rL_x = _mm_add_ps(_mm_mul_ps(rL_xL, c), _mm_mul_ps(rL_yL, s));
+    __m128 rL_y = _mm_add_ps(_mm_mul_ps(neg(rL_xL), s), _mm_mul_ps(rL_yL, c));
+    __m128 rR_x = _mm_add_ps(_mm_mul_ps(rR_xL, c), _mm_mul_ps(rR_yL, s));
+    __m128 rR_y = _mm_add_ps(_mm_mul_ps(neg(rR_xL), s), _mm_mul_ps(rR_yL, c));
+
+    __m128 rM_xL = _mm_sub_ps(zero, com);
+    __m128 rM_yL = _mm_set1_ps(-kH * 0.5f);
+    __m128 rM_x = _mm_add_ps(_mm_mul_ps(rM_xL, c), _mm_mul_ps(rM_yL, s));
+    __m128 rM_y = _mm_add_ps(_mm_mul_ps(neg(rM_xL), s), _mm_mul_ps(rM_yL, c));
+
+    __m128 Fm_x = _mm_add_ps(_mm_mul_ps(Fm_xL, c), _mm_mul_ps(Fm_yL, s));
+    __m128 Fm_y = _mm_add_ps(_mm_mul_ps(neg(Fm_xL), s), _mm_mul_ps(Fm_yL, c));
+
+    __m128 Fl_x = _mm_add_ps(_mm_mul_ps(Fl_xL, c), _mm_mul_ps(Fl_yL, s));
+    __m128 Fl_y = _mm_add_ps(_mm_mul_ps(neg(Fl_xL), s), _mm_mul_ps(Fl_yL, c));
+    __m128 Fr_x = _mm_add_ps(_mm_mul_ps(Fr_xL, c), _mm_mul_ps(Fr_yL, s));
+    __m128 Fr_y = _mm_add_ps(_mm_mul_ps(neg(Fr_xL), s), _mm_mul_ps(Fr_yL, c));
+
+    __m128 tau = _mm_add_ps(_mm_add_ps(
+                     _mm_sub_ps(_mm_mul_ps(rL_x, Fl_y), _mm_mul_ps(rL_y, Fl_x)),
+                     _mm_sub_ps(_mm_mul_ps(rR_x, Fr_y), _mm_mul_ps(rR_y, Fr_x))),
+                     _mm_sub_ps(_mm_mul_ps(rM_x, Fm_y), _mm_mul_ps(rM_y, Fm_x)));
+    __m128 alpha = _mm_div_ps(tau, _mm_set1_ps(kInertia));
+
+    const __m128 w0 = _mm_loadu_ps(L.angularVel + i);
+    const __m128 ang0 = _mm_loadu_ps(L.angle + i);
+    __m128 wv = _mm_add_ps(w0, _mm_mul_ps(alpha, dt));
+    wv = _mm_mul_ps(wv, _mm_set1_ps(RoverBody::ANGULAR_DAMPING));
+    __m128 ang = _mm_add_ps(ang0, _mm_mul_ps(wv, dt));
+
+    // Проверка посадки
+    __m128 ground = _mm_sub_ps(_mm_loadu_ps(L.terrain + i), _mm_set1_ps(RoverBody::GROUND_OFFSET));
+    __m128 touch = _mm_and_ps(live, _mm_cmpge_ps(y, ground));
+    __m128 safeSpeed = _mm_and_ps(_mm_cmplt_ps(_mm_and_ps(vy, absMask), _mm_set1_ps(2.0f)),
+                                  _mm_cmplt_ps(_mm_and_ps(vx, absMask), _mm_set1_ps(12.0f)));
+    __m128 legsDown = _mm_cmplt_ps(_mm_and_ps(ang, absMask), _mm_set1_ps(Config::MAX_LANDING_ANGLE_RAD));
+    __m128 ok = _mm_and_ps(safeSpeed, legsDown);
+
+    _mm_storeu_ps(L.touchdownVx + i, select(touch, vx, _mm_loadu_ps(L.touchdownVx + i)));
+    _mm_storeu_ps(L.touchdownVy + i, select(touch, vy, _mm_loadu_ps(L.touchdownVy + i)));
+    y  = select(touch, ground, y);
+    vx = _mm_andnot_ps(touch, vx);
+    vy = _mm_andnot_ps(touch, vy);
+    wv = _mm_andnot_ps(touch, wv);
+
+    const int touched = _mm_movemask_ps(touch);
+    const int okBits = _mm_movemask_ps(ok);
+    for (int k = 0; k < 4; ++k) {
+        if (!(touched & (1 << k))) continue;
+        if (okBits & (1 << k)) L.landed[i + k] = 1;
+        else L.crashed[i + k] = 1;
+    }
+
+    _mm_storeu_ps(L.x + i, select(live, x, x0));
+    _mm_storeu_ps(L.y + i, select(live, y, y0));
+    _mm_storeu_ps(L.vx + i, select(live, vx, vx0));
+    _mm_storeu_ps(L.vy + i, select(live, vy, vy0));
+    _mm_storeu_ps(L.angle + i, select(live, ang, ang0));
+    _mm_storeu_ps(L.angularVel + i, select(live, wv, w0));
+    _mm_storeu_ps(L.fuelMain + i, select(live, fuel, fuel0));
+    _mm_storeu_ps(L.comXLocal + i, select(live, com, com0));
+
+    _mm_storeu_ps(L.mainThrust + i, select(live, cmdMain, _mm_loadu_ps(L.mainThrust + i)));
+    _mm_storeu_ps(L.leftThrust + i, select(live, cmdLeft, _mm_loadu_ps(L.leftThrust + i)));
+    _mm_storeu_ps(L.rightThrust + i, select(live, cmdRight, _mm_loadu_ps(L.rightThrust + i)));
+    _mm_storeu_ps(L.leftGimbal + i, select(live, _mm_loadu_ps(L.cmdLeftGimbal + i), _mm_loadu_ps(L.leftGimbal + i)));
+    _mm_storeu_ps(L.rightGimbal + i, select(live, _mm_loadu_ps(L.cmdRightGimbal + i), _mm_loadu_ps(L.rightGimbal + i)));
+}
+
+#endif
+
+void BatchPhysicsEngine::resize(int n, int auxPerLander) {
+    count = std::max(0, n);
+    auxStride = std::max(0, auxPerLander);
+    const size_t sz = (size_t)count;
+
+    for (auto* v : {&x, &y, &vx, &vy, &angle, &angularVel, &fuelMain, &comXLocal,
+                    &mainThrust, &leftThrust, &rightThrust, &leftGimbal, &rightGimbal,
+                    &touchdownVx, &touchdownVy,
+                    &cmdMain, &cmdLeft, &cmdRight, &cmdLeftGimbal, &cmdRightGimbal,
+                    &windX, &windY,
+                    &cosAngle, &sinAngle, &cosLeft, &sinLeft, &cosRight, &sinRight}) {
+        v->assign(sz, 0.0f);
+    }
+    crashed.assign(sz, 0);
+    landed.assign(sz, 0);
+    auxTanks.assign(sz * (size_t)auxStride, 0.0f);
+    auxCount.assign(sz, 0);
+}
+
+void BatchPhysicsEngine::init(int i, float startX, float startY, float mainFuel, const std::vector<float>& aux) {
+    x[i] = startX; y[i] = startY;
+    vx[i] = 0.0f; vy[i] = 0.0f;
+    angle[i] = 0.0f; angularVel[i] = 0.0f;
+    fuelMain[i] = mainFuel;
+    comXLocal[i] = 0.0f;
+    crashed[i] = 0;
+    landed[i] = 0;
+    mainThrust[i] = 0.0f;
+    leftThrust[i] = 0.0f;
+    rightThrust[i] = 0.0f;
+    leftGimbal[i] = 0.0f;
+    rightGimbal[i] = 0.0f;
+    touchdownVx[i] = 0.0f;
+    touchdownVy[i] = 0.0f;
+
+    // лишние баки сверх auxStride отбрасываются
+    auxCount[i] = std::min((int)aux.size(), auxStride);
+    float* tanks = auxTanks.data() + (size_t)i * auxStride;
+    for (int k = 0; k < auxStride; ++k) tanks[k] = (k < auxCount[i]) ? aux[k] : 0.0f;
+}
+
+void BatchPhysicsEngine::setWind(Vec2 w) {
+    std::fill(windX.begin(), windX.end(), w.x);
+    std::fill(windY.begin(), windY.end(), w.y);
+}
+
+void BatchPhysicsEngine::setWind(int i, Vec2 w) {
+    windX[i] = w.x;
+    windY[i] = w.y;
+}
+
+void BatchPhysicsEngine::setControl(int i, const ControlOutput& c) {
+    cmdMain[i] = c.mainThrust;
+    cmdLeft[i] = c.leftThrust;
+    cmdRight[i] = c.rightThrust;
+    cmdLeftGimbal[i] = c.leftGimbal;
+    cmdRightGimbal[i] = c.rightGimbal;
+}
+
+RoverState BatchPhysicsEngine::getState(int i) const {
+    RoverState s;
+    s.x = x[i]; s.y = y[i];
+    s.vx = vx[i]; s.vy = vy[i];
+    s.angle = angle[i]; s.angularVel = angularVel[i];
+    s.fuelMain = fuelMain[i];
+    const float* tanks = auxTanks.data() + (size_t)i * auxStride;
+    s.auxTanks.assign(tanks, tanks + auxCount[i]);
+    s.comXLocal = comXLocal[i];
+    s.crashed = crashed[i] != 0;
+    s.landed = landed[i] != 0;
+    s.mainThrust = mainThrust[i];
+    s.leftThrust = leftThrust[i];
+    s.rightThrust = rightThrust[i];
+    s.leftGimbal = leftGimbal[i];
+    s.rightGimbal = rightGimbal[i];
+    s.touchdownVx = touchdownVx[i];
+    s.touchdownVy = touchdownVy[i];
+    return s;
+}
+
+void BatchPhysicsEngine::update(const float* terrainHeight) {
+    const int n = count;
+
+    // Скалярный проход: перекачка топлива и тригонометрия. Векторного sin/cos,
+    // совпадающего с libm до бита, нет — поэтому здесь, а не в основном цикле
+    for (int i = 0; i < n; ++i) {
+        if (crashed[i] || landed[i]) continue;
+
+        if (fuelMain[i] < RoverBody::FUEL_TRANSFER_BELOW) {
+            float* tanks = auxTanks.data() + (size_t)i * auxStride;
+            for (int k = 0; k < auxCount[i]; ++k) {
+                if (tanks[k] > 0) {
+                    float transfer = std::min(tanks[k], RoverBody::FUEL_TRANSFER);
+                    tanks[k] -= transfer;
+                    fuelMain[i] += transfer;
+                    break;
+                }
+            }
+        }
+
+        cosAngle[i] = std::cos(angle[i]);
+        sinAngle[i] = std::sin(angle[i]);
+        cosLeft[i] = std::cos(cmdLeftGimbal[i]);
+        sinLeft[i] = std::sin(cmdLeftGimbal[i]);
+        cosRight[i] = std::cos(cmdRightGimbal[i]);
+        sinRight[i] = std::sin(cmdRightGimbal[i]);
+    }
+
+    const BatchLanes L{
+        x.data(), y.data(), vx.data(), vy.data(), angle.data(), angularVel.data(),
+        fuelMain.data(), comXLocal.data(),
+        mainThrust.data(), leftThrust.data(), rightThrust.data(), leftGimbal.data(), rightGimbal.data(),
+        touchdownVx.data(), touchdownVy.data(),
+        crashed.data(), landed.data(),
+        cmdMain.data(), cmdLeft.data(), cmdRight.data(), cmdLeftGimbal.data(), cmdRightGimbal.data(),
+        windX.data(), windY.data(),
+        cosAngle.data(), sinAngle.data(), cosLeft.data(), sinLeft.data(), cosRight.data(), sinRight.data(),
+        terrainHeight};
+
+    int i = 0;
+#if LANDER_BATCH_SSE
+    for (; i + 4 <= n; i += 4) stepLanesSse(L, i);
+#endif
+    for (; i < n; ++i) stepLane(L, i);
+}
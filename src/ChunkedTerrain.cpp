@@ -0,0 +1,142 @@
+#include "ChunkedTerrain.h"
+#include "Trace.h"
+#include <algorithm>
+
+ChunkedTerrain::ChunkedTerrain(int capacity, bool prefetchEnabled)
+    : capacity(std::max(1, capacity)), prefetchEnabled(prefetchEnabled) {}
+
+ChunkedTerrain::~ChunkedTerrain() {
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stopping = true;
+    }
+    wake.notify_all();
+    if (worker.joinable()) worker.join();
+}
+
+void ChunkedTerrain::reset(int newSeed) {
+    std::lock_guard<std::mutex> lock(m);
+    seed = newSeed;
+    ++generation;
+    cache.clear();
+    lru.clear();
+    queue.clear();
+    counters = Stats{};
+}
+
+void ChunkedTerrain::insert(int index, Chunk data) {
+    auto it = cache.find(index);
+    if (it != cache.end()) {
+        lru.splice(lru.begin(), lru, it->second.lruPos);
+        return;
+    }
+    lru.push_front(index);
+    cache.emplace(index, Entry{std::move(data), lru.begin()});
+    while ((int)cache.size() > capacity) {
+        cache.erase(lru.back());
+        lru.pop_back();
+    }
+}
+
+bool ChunkedTerrain::isInFlight(int index) const {
+    return std::find(inFlight.begin(), inFlight.end(), index) != inFlight.end();
+}
+
+void ChunkedTerrain::finish(int index) {
+    inFlight.erase(std::find(inFlight.begin(), inFlight.end(), index));
+    ready.notify_all();
+}
+
+ChunkedTerrain::Chunk ChunkedTerrain::chunk(int index) {
+    std::unique_lock<std::mutex> lock(m);
+    ready.wait(lock, [&] { return !isInFlight(index); });
+
+    auto it = cache.find(index);
+    if (it != cache.end()) {
+        ++counters.hits;
+        lru.splice(lru.begin(), lru, it->second.lruPos);
+        return it->second.data;
+    }
+
+    ++counters.misses;
+    inFlight.push_back(index);
+    int s = seed;
+    unsigned gen0 = generation;
+    lock.unlock();
+    Chunk data;
+    try {
+        data = std::make_shared<const std::vector<float>>(gen.generateChunk(s, index, CHUNK_WIDTH));
+    } catch (...) {
+        lock.lock();
+        finish(index);
+        throw;
+    }
+    lock.lock();
+    if (generation == gen0) insert(index, data);
+    finish(index);
+    return data;
+}
+
+void ChunkedTerrain::prefetch(const int* indices, int count) {
+    if (!prefetchEnabled) return;
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> lock(m);
+        for (int i = 0; i < count; ++i) {
+            int index = indices[i];
+            if (isInFlight(index) || cache.count(index)) continue;
+            if (std::find(queue.begin(), queue.end(), index) != queue.end()) continue;
+            queue.push_back(index);
+            queued = true;
+        }
+        if (queued && !worker.joinable()) worker = std::thread([this] { prefetchLoop(); });
+    }
+    if (queued) wake.notify_one();
+}
+
+void ChunkedTerrain::assemble(int first, int count, std::vector<float>& out) {
+    out.resize((size_t)count * CHUNK_WIDTH);
+    for (int i = 0; i < count; ++i) {
+        Chunk c = chunk(first + i);
+        std::copy(c->begin(), c->end(), out.begin() + (size_t)i * CHUNK_WIDTH);
+    }
+}
+
+ChunkedTerrain::Stats ChunkedTerrain::stats() const {
+    std::lock_guard<std::mutex> lock(m);
+    Stats s = counters;
+    s.resident = (int)cache.size();
+    return s;
+}
+
+void ChunkedTerrain::prefetchLoop() {
+    Trace::setThreadName("terrain prefetch");
+    std::unique_lock<std::mutex> lock(m);
+    while (true) {
+        wake.wait(lock, [&] { return stopping || !queue.empty(); });
+        if (stopping) return;
+
+        int index = queue.front();
+        queue.pop_front();
+        if (isInFlight(index) || cache.count(index)) continue;
+
+        inFlight.push_back(index);
+        int s = seed;
+        unsigned gen0 = generation;
+        prefetchGen.cfg = gen.cfg;
+        lock.unlock();
+        Chunk data;
+        try {
+            data = std::make_shared<const std::vector<float>>(
+                prefetchGen.generateChunk(s, index, CHUNK_WIDTH));
+        } catch (...) {
+            // предвыборка необязательна: кусок досчитает chunk()
+        }
+        lock.lock();
+        if (data && generation == gen0) {
+            insert(index, data);
+            ++counters.prefetched;
+        }
+        finish(index);
+    }
+}
@@ -0,0 +1,68 @@
+#include "HeightPyramid.h"
+#include <algorithm>
+#include <limits>
+
+void HeightPyramid::build(const std::vector<float>& terrain) {
+    clear();
+    if (terrain.size() < 2) return;
+
+    const size_t n = terrain.size() - 1;
+    std::vector<float> mins(n), maxs(n);
+    for (size_t i = 0; i < n; ++i) {
+        mins[i] = std::min(terrain[i], terrain[i + 1]);
+        maxs[i] = std::max(terrain[i], terrain[i + 1]);
+    }
+    minLevels.push_back(std::move(mins));
+    maxLevels.push_back(std::move(maxs));
+
+    // последний блок уровня может быть неполным — он собирается из того, что есть
+    while (minLevels.back().size() > 1) {
+        const std::vector<float>& pmin = minLevels.back();
+        const std::vector<float>& pmax = maxLevels.back();
+        size_t m = (pmin.size() + 1) / 2;
+
+        std::vector<float> lmin(m), lmax(m);
+        for (size_t j = 0; j < m; ++j) {
+            size_t a = 2 * j;
+            size_t b = std::min(a + 1, pmin.size() - 1);
+            lmin[j] = std::min(pmin[a], pmin[b]);
+            lmax[j] = std::max(pmax[a], pmax[b]);
+        }
+        minLevels.push_back(std::move(lmin));
+        maxLevels.push_back(std::move(lmax));
+    }
+}
+
+void HeightPyramid::clear() {
+    minLevels.clear();
+    maxLevels.clear();
+}
+
+template <typename Pick>
+float HeightPyramid::rangeQuery(const std::vector<std::vector<float>>& lv, int x0, int x1,
+                                float identity, Pick pick) const {
+    x0 = std::max(x0, 0);
+    x1 = std::min(x1, segments() - 1);
+
+    // жадно берём наибольшие выровненные блоки, целиком лежащие в [x0, x1]
+    float r = identity;
+    while (x0 <= x1) {
+        int k = 0;
+        while (k + 1 < levels() &&
+               (x0 & ((1 << (k + 1)) - 1)) == 0 &&
+               x0 + (1 << (k + 1)) - 1 <= x1) ++k;
+        r = pick(r, lv[k][x0 >> k]);
+        x0 += 1 << k;
+    }
+    return r;
+}
+
+float HeightPyramid::minY(int x0, int x1) const {
+    return rangeQuery(minLevels, x0, x1, std::numeric_limits<float>::infinity(),
+                      [](float a, float b){ return std::min(a, b); });
+}
+
+float HeightPyramid::maxY(int x0, int x1) const {
+    return rangeQuery(maxLevels, x0, x1, -std::numeric_limits<float>::infinity(),
+                      [](float a, float b){ return std::max(a, b); });
+}
@@ -39,18 +39,18 @@ const char* LandingController::getPhaseName() const {
     }
 }
 
-static float estimateGroundY(const std::vector<RayHit>& hits, float fallbackY) {
+static float estimateGroundY(const RadarHitBuffer& hits, float fallbackY) {
     // Берём ближайшее пересечение
     float bestT = 1e9f;
     float bestY = fallbackY;
-    for (const auto& h : hits) {
-        if (!h.hit) continue;
-        if (h.t < bestT) { bestT = h.t; bestY = h.point.y; }
+    for (int i = 0; i < hits.size(); ++i) {
+        if (!hits.hit[i]) continue;
+        if (hits.t[i] < bestT) { bestT = hits.t[i]; bestY = hits.py[i]; }
     }
     return bestY;
 }
 
-ControlOutput LandingController::compute(const RoverState& state, const std::vector<RayHit>& radarHits) {
+ControlOutput LandingController::compute(const RoverState& state, const RadarHitBuffer& radarHits) {
     ControlOutput out{};
     out.leftGimbal = 0.0f;
     out.rightGimbal = 0.0f;
@@ -66,7 +66,7 @@ ControlOutput LandingController::compute(const RoverState& state, const std::vec
         DetectorConfig detCfg;
         detCfg.maxSlope = std::tan(Config::MAX_LANDING_ANGLE_RAD);
         detCfg.maxBandY = std::max(detCfg.maxBandY, detCfg.maxSlope * detCfg.minLenX);
-        auto sites = detectLandingSites(radarHits, state.x, detCfg);
+        const auto& sites = detectLandingSites(radarHits, state.x, detCfg, detScratch);
         haveTarget = pickBestSite(sites, targetSite);
     }
 
@@ -2,35 +2,32 @@
 #include <algorithm>
 #include <cmath>
 
+float defaultMaxBandY() {
+    return std::tan(Config::MAX_LANDING_ANGLE_RAD);
+}
+
 static float clampf(float v, float a, float b){ return std::max(a, std::min(v, b)); }
 
-std::vector<LandingSite> detectLandingSites(const std::vector<RayHit>& hits,
-                                            float roverX,
-                                            const DetectorConfig& cfg)
+// pts(k) — k-я точка по возрастанию x, count точек
+template <typename Points>
+static void detectFromPoints(const Points& pts, size_t count,
+                             float roverX,
+                             const DetectorConfig& cfg,
+                             std::vector<LandingSite>& out)
 {
-    // реальные попадания
-    std::vector<Vec2> pts;
-    pts.reserve(hits.size());
-    for (const auto& h : hits) {
-        if (h.hit) pts.push_back(h.point);
-    }
-    if (pts.size() < 2) return {};
-
-    
-    std::sort(pts.begin(), pts.end(), [](const Vec2& a, const Vec2& b){ return a.x < b.x; });
-
-    std::vector<LandingSite> out;
+    out.clear();
+    if (count < 2) return;
 
     size_t start = 0;
-    while (start + 1 < pts.size()) {
+    while (start + 1 < count) {
         size_t end = start;
 
-        float yMin = pts[start].y, yMax = pts[start].y;
-        float ySum = pts[start].y;
+        float yMin = pts(start).y, yMax = pts(start).y;
+        float ySum = pts(start).y;
 
-        while (end + 1 < pts.size()) {
-            Vec2 p0 = pts[end];
-            Vec2 p1 = pts[end + 1];
+        while (end + 1 < count) {
+            Vec2 p0 = pts(end);
+            Vec2 p1 = pts(end + 1);
             float dx = p1.x - p0.x;
             if (dx <= 1e-5f) { end++; continue; }
 
@@ -41,15 +38,17 @@ std::vector<LandingSite> detectLandingSites(const std::vector<RayHit>& hits,
             if (std::abs(slope) > cfg.maxSlope) break;
 
             end++;
-            yMin = std::min(yMin, pts[end].y);
-            yMax = std::max(yMax, pts[end].y);
-            ySum += pts[end].y;
+            yMin = std::min(yMin, p1.y);
+            yMax = std::max(yMax, p1.y);
+            ySum += p1.y;
 
             if ((yMax - yMin) > cfg.maxBandY) break;
         }
 
-        float x0 = pts[start].x;
-        float x1 = pts[end].x;
+        Vec2 first = pts(start);
+        Vec2 last = pts(end);
+        float x0 = first.x;
+        float x1 = last.x;
         float lenX = x1 - x0;
 
         if (lenX >= cfg.minLenX) {
@@ -58,7 +57,7 @@ std::vector<LandingSite> detectLandingSites(const std::vector<RayHit>& hits,
             s.x1 = x1;
             s.centerX = 0.5f * (x0 + x1);
             s.yMean = ySum / (float)(end - start + 1);
-            s.slope = (pts[end].y - pts[start].y) / std::max(1e-5f, (pts[end].x - pts[start].x));
+            s.slope = (last.y - first.y) / std::max(1e-5f, (last.x - first.x));
 
             // длина важна, дальность штрафуем
             float dist = std::abs(s.centerX - roverX);
@@ -73,10 +72,54 @@ std::vector<LandingSite> detectLandingSites(const std::vector<RayHit>& hits,
     std::sort(out.begin(), out.end(), [](const LandingSite& a, const LandingSite& b){
         return a.score > b.score;
     });
+}
+
+std::vector<LandingSite> detectLandingSites(const std::vector<RayHit>& hits,
+                                            float roverX,
+                                            const DetectorConfig& cfg)
+{
+    // реальные попадания
+    std::vector<Vec2> pts;
+    pts.reserve(hits.size());
+    for (const auto& h : hits) {
+        if (h.hit) pts.push_back(h.point);
+    }
+    std::sort(pts.begin(), pts.end(), [](const Vec2& a, const Vec2& b){ return a.x < b.x; });
 
+    std::vector<LandingSite> out;
+    detectFromPoints([&](size_t k) { return pts[k]; }, pts.size(), roverX, cfg, out);
     return out;
 }
 
+std::vector<LandingSite> detectLandingSites(const RadarHitBuffer& hits,
+                                            float roverX,
+                                            const DetectorConfig& cfg)
+{
+    DetectorScratch scratch;
+    detectLandingSites(hits, roverX, cfg, scratch);
+    return std::move(scratch.sites);
+}
+
+const std::vector<LandingSite>& detectLandingSites(const RadarHitBuffer& hits,
+                                                   float roverX,
+                                                   const DetectorConfig& cfg,
+                                                   DetectorScratch& scratch)
+{
+    std::vector<int>& order = scratch.order;
+    order.clear();
+    for (int i = 0; i < hits.size(); ++i) {
+        if (hits.hit[i]) order.push_back(i);
+    }
+    // тот же порядок сравнений, что и при сортировке самих точек
+    const float* px = hits.px.data();
+    std::sort(order.begin(), order.end(), [px](int a, int b){ return px[a] < px[b]; });
+
+    const float* py = hits.py.data();
+    detectFromPoints([&](size_t k) { return Vec2{px[order[k]], py[order[k]]}; },
+                     order.size(), roverX, cfg, scratch.sites);
+    return scratch.sites;
+}
+
 bool pickBestSite(const std::vector<LandingSite>& sites, LandingSite& outBest) {
     if (sites.empty()) return false;
     outBest = sites.front();
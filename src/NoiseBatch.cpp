@@ -0,0 +1,268 @@
+#include "NoiseBatch.h"
+#include "FastNoiseLite.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define LANDER_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define LANDER_TARGET(isa)
+    #else
+        #define LANDER_TARGET(isa) __attribute__((target(isa)))
+    #endif
+#else
+    #define LANDER_X86 0
+#endif
+
+void noiseFbmScalar(const NoiseFbmConfig& cfg, const float* xs, const float* ys,
+                    float* out, int n)
+{
+    FastNoiseLite noise;
+    noise.SetSeed(cfg.seed);
+    noise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
+    noise.SetFractalType(FastNoiseLite::FractalType_FBm);
+    noise.SetFractalOctaves(cfg.octaves);
+    noise.SetFractalLacunarity(cfg.lacunarity);
+    noise.SetFractalGain(cfg.gain);
+    noise.SetFractalWeightedStrength(cfg.weightedStrength);
+    noise.SetFrequency(cfg.frequency);
+    for (int i = 0; i < n; ++i) out[i] = noise.GetNoise(xs[i], ys[i]);
+}
+
+#if LANDER_X86
+
+// Таблица градиентов FastNoiseLite (Lookup::Gradients2D): у неё закрытый
+// доступ, а для gather нужен сам массив
+alignas(32) static const float kGradients2D[256] = {
+    0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+    0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+    0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+    -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+    -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+    -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+    0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+    0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+    0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+    -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+    -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+    -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+    0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+    0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+    0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+    -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+    -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+    -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+    0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+    0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+    0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+    -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+    -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+    -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+    0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+    0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+    0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+    -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+    -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+    -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+    0.38268343236509f, 0.923879532511287f, 0.923879532511287f, 0.38268343236509f, 0.923879532511287f, -0.38268343236509f, 0.38268343236509f, -0.923879532511287f,
+    -0.38268343236509f, -0.923879532511287f, -0.923879532511287f, -0.38268343236509f, -0.923879532511287f, 0.38268343236509f, -0.38268343236509f, 0.923879532511287f,
+};
+
+// Константы в тех же выражениях, что в FastNoiseLite::SingleSimplex и
+// TransformNoiseCoordinate, — чтобы и округлялись так же
+static const float kSqrt3 = 1.7320508075688772935274463415059f;
+static const float kF2 = 0.5f * (kSqrt3 - 1);
+static const float kG2 = (3 - kSqrt3) / 6;
+static const int kPrimeX = 501125321;
+static const int kPrimeY = 1136930381;
+
+// То же, что FastNoiseLite::CalculateFractalBounding
+static float fractalBounding(const NoiseFbmConfig& cfg) {
+    float gain = std::abs(cfg.gain);
+    float amp = gain;
+    float ampFractal = 1.0f;
+    for (int i = 1; i < cfg.octaves; ++i) {
+        ampFractal += amp;
+        amp *= gain;
+    }
+    return 1 / ampFractal;
+}
+
+// GradCoord: хеш вершины -> градиент из таблицы -> скалярное произведение
+LANDER_TARGET("avx2")
+static __m256 gradCoord8(__m256i seed, __m256i xPrimed, __m256i yPrimed, __m256 xd, __m256 yd) {
+    __m256i hash = _mm256_xor_si256(seed, _mm256_xor_si256(xPrimed, yPrimed));
+    hash = _mm256_mullo_epi32(hash, _mm256_set1_epi32(0x27d4eb2d));
+    hash = _mm256_xor_si256(hash, _mm256_srai_epi32(hash, 15));
+    hash = _mm256_and_si256(hash, _mm256_set1_epi32(127 << 1));
+
+    __m256 xg = _mm256_i32gather_ps(kGradients2D, hash, 4);
+    __m256 yg = _mm256_i32gather_ps(kGradients2D + 1, hash, 4);
+    return _mm256_add_ps(_mm256_mul_ps(xd, xg), _mm256_mul_ps(yd, yg));
+}
+
+// SingleSimplex для восьми точек; координаты уже скошены
+LANDER_TARGET("avx2")
+static __m256 simplex8(__m256i seed, __m256 x, __m256 y) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 g2 = _mm256_set1_ps(kG2);
+    const __m256 g2m1 = _mm256_set1_ps(kG2 - 1);
+    const __m256 cT = _mm256_set1_ps((float)(2 * (1 - 2 * kG2) * (1 / kG2 - 2)));
+    const __m256 cA = _mm256_set1_ps((float)(-2 * (1 - 2 * kG2) * (1 - 2 * kG2)));
+    const __m256 off2 = _mm256_set1_ps(2 * (float)kG2 - 1);
+    const __m256i primeX = _mm256_set1_epi32(kPrimeX);
+    const __m256i primeY = _mm256_set1_epi32(kPrimeY);
+
+    // FastFloor: отсечение к нулю и -1 для отрицательных
+    __m256i i = _mm256_cvttps_epi32(x);
+    __m256i j = _mm256_cvttps_epi32(y);
+    i = _mm256_add_epi32(i, _mm256_castps_si256(_mm256_cmp_ps(x, zero, _CMP_LT_OQ)));
+    j = _mm256_add_epi32(j, _mm256_castps_si256(_mm256_cmp_ps(y, zero, _CMP_LT_OQ)));
+    __m256 xi = _mm256_sub_ps(x, _mm256_cvtepi32_ps(i));
+    __m256 yi = _mm256_sub_ps(y, _mm256_cvtepi32_ps(j));
+
+    __m256 t = _mm256_mul_ps(_mm256_add_ps(xi, yi), g2);
+    __m256 x0 = _mm256_sub_ps(xi, t);
+    __m256 y0 = _mm256_sub_ps(yi, t);
+
+    i = _mm256_mullo_epi32(i, primeX);
+    j = _mm256_mullo_epi32(j, primeY);
+
+    // Веса считаются для всех точек, вклад с неположительным весом обнуляется
+    __m256 a = _mm256_sub_ps(_mm256_sub_ps(half, _mm256_mul_ps(x0, x0)), _mm256_mul_ps(y0, y0));
+    __m256 aa = _mm256_mul_ps(a, a);
+    __m256 n0 = _mm256_mul_ps(_mm256_mul_ps(aa, aa), gradCoord8(seed, i, j, x0, y0));
+    n0 = _mm256_and_ps(n0, _mm256_cmp_ps(a, zero, _CMP_GT_OQ));
+
+    __m256 c = _mm256_add_ps(_mm256_mul_ps(cT, t), _mm256_add_ps(cA, a));
+    __m256 x2 = _mm256_add_ps(x0, off2);
+    __m256 y2 = _mm256_add_ps(y0, off2);
+    __m256 cc = _mm256_mul_ps(c, c);
+    __m256 n2 = _mm256_mul_ps(_mm256_mul_ps(cc, cc),
+                              gradCoord8(seed, _mm256_add_epi32(i, primeX), _mm256_add_epi32(j, primeY), x2, y2));
+    n2 = _mm256_and_ps(n2, _mm256_cmp_ps(c, zero, _CMP_GT_OQ));
+
+    // Третья вершина — (i, j+1) выше диагонали, (i+1, j) ниже
+    __m256 upper = _mm256_cmp_ps(y0, x0, _CMP_GT_OQ);
+    __m256 x1 = _mm256_add_ps(x0, _mm256_blendv_ps(g2m1, g2, upper));
+    __m256 y1 = _mm256_add_ps(y0, _mm256_blendv_ps(g2, g2m1, upper));
+    __m256i upperI = _mm256_castps_si256(upper);
+    __m256i i1 = _mm256_add_epi32(i, _mm256_andnot_si256(upperI, primeX));
+    __m256i j1 = _mm256_add_epi32(j, _mm256_and_si256(upperI, primeY));
+    __m256 b = _mm256_sub_ps(_mm256_sub_ps(half, _mm256_mul_ps(x1, x1)), _mm256_mul_ps(y1, y1));
+    __m256 bb = _mm256_mul_ps(b, b);
+    __m256 n1 = _mm256_mul_ps(_mm256_mul_ps(bb, bb), gradCoord8(seed, i1, j1, x1, y1));
+    n1 = _mm256_and_ps(n1, _mm256_cmp_ps(b, zero, _CMP_GT_OQ));
+
+    return _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(n0, n1), n2), _mm256_set1_ps(99.83685446303647f));
+}
+
+// GetNoise для восьми точек: частота, скос OpenSimplex2, октавы FBm
+LANDER_TARGET("avx2")
+static __m256 fbm8(const NoiseFbmConfig& cfg, float bounding, __m256 x, __m256 y) {
+    const __m256 freq = _mm256_set1_ps(cfg.frequency);
+    const __m256 lac = _mm256_set1_ps(cfg.lacunarity);
+    const __m256 gain = _mm256_set1_ps(cfg.gain);
+    const __m256 ws = _mm256_set1_ps(cfg.weightedStrength);
+    const __m256 one = _mm256_set1_ps(1.0f), two = _mm256_set1_ps(2.0f), half = _mm256_set1_ps(0.5f);
+
+    x = _mm256_mul_ps(x, freq);
+    y = _mm256_mul_ps(y, freq);
+    __m256 t = _mm256_mul_ps(_mm256_add_ps(x, y), _mm256_set1_ps(kF2));
+    x = _mm256_add_ps(x, t);
+    y = _mm256_add_ps(y, t);
+
+    __m256 sum = _mm256_setzero_ps();
+    __m256 amp = _mm256_set1_ps(bounding);
+    for (int o = 0; o < cfg.octaves; ++o) {
+        __m256i seed = _mm256_set1_epi32((int)((unsigned)cfg.seed + (unsigned)o));
+        __m256 noise = simplex8(seed, x, y);
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(noise, amp));
+        // Lerp(1, FastMin(noise + 1, 2) * 0.5, weightedStrength)
+        __m256 w = _mm256_mul_ps(_mm256_min_ps(_mm256_add_ps(noise, one), two), half);
+        amp = _mm256_mul_ps(amp, _mm256_add_ps(one, _mm256_mul_ps(ws, _mm256_sub_ps(w, one))));
+
+        x = _mm256_mul_ps(x, lac);
+        y = _mm256_mul_ps(y, lac);
+        amp = _mm256_mul_ps(amp, gain);
+    }
+    return sum;
+}
+
+LANDER_TARGET("avx2")
+static void noiseFbmAvx2(const NoiseFbmConfig& cfg, const float* xs, const float* ys,
+                         float* out, int n)
+{
+    const float bounding = fractalBounding(cfg);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = fbm8(cfg, bounding, _mm256_loadu_ps(xs + i), _mm256_loadu_ps(ys + i));
+        _mm256_storeu_ps(out + i, v);
+    }
+    // хвост — через те же восемь дорожек, чтобы значения не зависели от положения в массиве
+    if (i < n) {
+        alignas(32) float tx[8] = {}, ty[8] = {}, to[8];
+        std::copy(xs + i, xs + n, tx);
+        std::copy(ys + i, ys + n, ty);
+        _mm256_store_ps(to, fbm8(cfg, bounding, _mm256_load_ps(tx), _mm256_load_ps(ty)));
+        std::copy(to, to + (n - i), out + i);
+    }
+}
+
+static bool cpuSupports(NoiseKernelIsa isa) {
+    if (isa == NoiseKernelIsa::Scalar) return true;
+#if defined(_MSC_VER) && !defined(__clang__)
+    int r[4];
+    __cpuid(r, 1);
+    bool osxsave = (r[2] & (1 << 27)) != 0;
+    bool avx = (r[2] & (1 << 28)) != 0;
+    // AVX-регистры должен сохранять и сам ОС
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;
+    __cpuid(r, 0);
+    if (r[0] < 7) return false;
+    __cpuidex(r, 7, 0);
+    return (r[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#else
+
+static bool cpuSupports(NoiseKernelIsa isa) { return isa == NoiseKernelIsa::Scalar; }
+
+#endif
+
+NoiseFbmFn noiseFbmKernelFor(NoiseKernelIsa isa) {
+    if (!cpuSupports(isa)) return nullptr;
+    switch (isa) {
+#if LANDER_X86
+        case NoiseKernelIsa::Avx2: return noiseFbmAvx2;
+#endif
+        case NoiseKernelIsa::Scalar: return noiseFbmScalar;
+        default: return nullptr;
+    }
+}
+
+NoiseKernelIsa noiseFbmKernelIsa() {
+    static const NoiseKernelIsa isa =
+        cpuSupports(NoiseKernelIsa::Avx2) ? NoiseKernelIsa::Avx2 : NoiseKernelIsa::Scalar;
+    return isa;
+}
+
+NoiseFbmFn noiseFbmKernel() {
+    static const NoiseFbmFn fn = noiseFbmKernelFor(noiseFbmKernelIsa());
+    return fn;
+}
+
+const char* noiseKernelIsaName(NoiseKernelIsa isa) {
+    switch (isa) {
+        case NoiseKernelIsa::Avx2:   return "AVX2";
+        case NoiseKernelIsa::Scalar: return "scalar";
+        default:                     return "?";
+    }
+}
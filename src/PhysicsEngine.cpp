@@ -15,22 +15,22 @@ void PhysicsEngine::init(float startX, float startY, float mainFuel, const std::
     state.rightThrust = 0.0f;
     state.leftGimbal = 0.0f;
     state.rightGimbal = 0.0f;
+    state.touchdownVx = 0.0f;
+    state.touchdownVy = 0.0f;
 }
 
-void PhysicsEngine::setWind(sf::Vector2f w) {
+void PhysicsEngine::setWind(Vec2 w) {
     windForce = w;
 }
 
-RoverState PhysicsEngine::getState() const { return state; }
-
 void PhysicsEngine::update(ControlOutput input, float terrainHeight) {
     if (state.crashed || state.landed) return;
 
     // Перекачка топлива
-    if (state.fuelMain < 100.0f) {
+    if (state.fuelMain < RoverBody::FUEL_TRANSFER_BELOW) {
         for (float& tank : state.auxTanks) {
             if (tank > 0) {
-                float transfer = std::min(tank, 5.0f); 
+                float transfer = std::min(tank, RoverBody::FUEL_TRANSFER);
                 tank -= transfer;
                 state.fuelMain += transfer;
                 break; 
@@ -39,14 +39,14 @@ void PhysicsEngine::update(ControlOutput input, float terrainHeight) {
     }
 
     const float dt = Config::DT;
-    const float mass = 10.0f;
-    const float groundoffset = 20.0f; 
-    const float w = 20.0f;
-    const float h = 16.0f;
+    const float mass = RoverBody::MASS;
+    const float groundoffset = RoverBody::GROUND_OFFSET;
+    const float w = RoverBody::WIDTH;
+    const float h = RoverBody::HEIGHT;
     const float I = (1.0f / 12.0f) * mass * (w*w + h*h); 
 
-    const float maxComShift = 1.2f;
-    const float comTau      = 0.65f;   
+    const float maxComShift = RoverBody::MAX_COM_SHIFT;
+    const float comTau      = RoverBody::COM_TAU;
 
     float c0 = std::cos(state.angle);
     float s0 = std::sin(state.angle);
@@ -94,8 +94,8 @@ void PhysicsEngine::update(ControlOutput input, float terrainHeight) {
     ax += (windForce.x / mass);
     ay += (-windForce.y / mass);
 
-    const float linearDragX = 0.35f;
-    const float linearDragY = 0.10f;
+    const float linearDragX = RoverBody::LINEAR_DRAG_X;
+    const float linearDragY = RoverBody::LINEAR_DRAG_Y;
     ax += -linearDragX * state.vx;
     ay += -linearDragY * state.vy;
 
@@ -130,7 +130,7 @@ void PhysicsEngine::update(ControlOutput input, float terrainHeight) {
     float alpha = tau / I; 
 
     state.angularVel += alpha * dt;
-    state.angularVel *= 0.90f;
+    state.angularVel *= RoverBody::ANGULAR_DAMPING;
     state.angle += state.angularVel * dt;
 
     // Проверка посадки
@@ -144,6 +144,9 @@ void PhysicsEngine::update(ControlOutput input, float terrainHeight) {
         if (safeSpeed && bothLegsDown) state.landed = true;
         else state.crashed = true; 
 
+        state.touchdownVx = state.vx;
+        state.touchdownVy = state.vy;
+
         state.vx = 0; state.vy = 0; state.angularVel = 0;
     }
 
@@ -0,0 +1,82 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+    // Замеры в наносекундах; 0 — пустой слот
+    struct StageRing {
+        std::atomic<std::uint32_t> next{0};
+        std::atomic<std::uint32_t> samples[Profiler::WINDOW];
+    };
+
+    StageRing rings[PROFILE_STAGE_COUNT];
+}
+
+std::atomic<bool> Profiler::enabledFlag{false};
+
+void Profiler::setEnabled(bool on) {
+    if (on && !enabled()) {
+        for (StageRing& r : rings) {
+            for (auto& s : r.samples) s.store(0, std::memory_order_relaxed);
+            r.next.store(0, std::memory_order_relaxed);
+        }
+    }
+    enabledFlag.store(on, std::memory_order_relaxed);
+}
+
+void Profiler::record(ProfileStage stage, std::int64_t ns) {
+    const std::int64_t maxNs = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t v = (std::uint32_t)std::clamp<std::int64_t>(ns, 1, maxNs);
+    StageRing& r = rings[(int)stage];
+    std::uint32_t slot = r.next.fetch_add(1, std::memory_order_relaxed) % WINDOW;
+    r.samples[slot].store(v, std::memory_order_relaxed);
+}
+
+ProfileReport Profiler::report() {
+    ProfileReport rep;
+    std::uint32_t buf[WINDOW];
+    for (int s = 0; s < PROFILE_STAGE_COUNT; ++s) {
+        int n = 0;
+        for (auto& v : rings[s].samples) {
+            std::uint32_t x = v.load(std::memory_order_relaxed);
+            if (x) buf[n++] = x;
+        }
+        ProfileStageStats& st = rep.stages[s];
+        st.samples = n;
+        if (n == 0) continue;
+
+        double sum = 0.0;
+        for (int i = 0; i < n; ++i) sum += buf[i];
+        int k = std::min(n - 1, (int)(n * 0.99));
+        std::nth_element(buf, buf + k, buf + n);
+        st.p99Us = buf[k] * 1e-3f;
+        st.maxUs = *std::max_element(buf + k, buf + n) * 1e-3f;
+        st.meanUs = (float)(sum / n * 1e-3);
+    }
+    return rep;
+}
+
+const char* Profiler::stageName(ProfileStage stage) {
+    switch (stage) {
+        case ProfileStage::SimStep:        return "sim step";
+        case ProfileStage::RadarScan:      return "radar scan";
+        case ProfileStage::DetectSites:    return "detect sites";
+        case ProfileStage::Controller:     return "controller";
+        case ProfileStage::Physics:        return "physics";
+        case ProfileStage::TerrainGen:     return "terrain gen";
+        case ProfileStage::Frame:          return "frame";
+        case ProfileStage::DrawBackground: return "draw background";
+        case ProfileStage::DrawRadar:      return "draw radar";
+        case ProfileStage::DrawLander:     return "draw lander";
+        case ProfileStage::DrawHud:        return "draw hud";
+        default:                           return "?";
+    }
+}
+
+bool Profiler::stageNested(ProfileStage stage) {
+    return stage != ProfileStage::SimStep && stage != ProfileStage::TerrainGen && stage != ProfileStage::Frame;
+}
+
+const char* Profiler::stageCategory(ProfileStage stage) {
+    return stage >= ProfileStage::Frame ? "render" : "sim";
+}
@@ -1,4 +1,7 @@
 #include "RadarTypes.h"
+#include "HeightPyramid.h"
+#include "RaySegmentKernel.h"
+#include "WorkerPool.h"
 #include <cmath>
 #include <algorithm>
 
@@ -39,54 +42,453 @@ static bool raySegmentIntersect(Vec2 O, Vec2 D, Vec2 A, Vec2 B, float& outT, flo
     return false;
 }
 
-std::vector<RayHit> scanRadar(const std::vector<float>& terrain,
-                              Vec2 origin,
-                              float shipAngleRad,
-                              const RadarConfig& cfg)
+// Учитывает отрезок x как кандидата: побеждает меньший t, при равенстве — меньший индекс
+// (тот же порядок, что даёт полный перебор по возрастанию x)
+static void considerSegment(const std::vector<float>& terrain, Vec2 O, Vec2 D, int x,
+                            float maxRange, RayHit& best)
 {
-    std::vector<RayHit> hits;
-    if (terrain.size() < 2 || cfg.rays <= 0) return hits;
+    Vec2 A{(float)x, terrain[x]};
+    Vec2 B{(float)(x + 1), terrain[x + 1]};
+
+    float t, u;
+    if (!raySegmentIntersect(O, D, A, B, t, u)) return;
+    if (t > maxRange) return;
+
+    if (!best.hit || t < best.t || (t == best.t && x < best.segIndex)) {
+        best.hit = true;
+        best.t = t;
+        best.point = O + D * t;
+        best.segIndex = x;
+    }
+}
+
+// Столбцы [lo, hi] одним вызовом векторного ядра, с тем же правилом выбора
+static void considerRange(const std::vector<float>& terrain, Vec2 O, Vec2 D, int lo, int hi,
+                          float maxRange, RayHit& best)
+{
+    float t;
+    int x = raySegmentsKernel()(terrain.data(), lo, hi - lo + 1, O, D, maxRange, t);
+    if (x < 0) return;
+
+    if (!best.hit || t < best.t || (t == best.t && x < best.segIndex)) {
+        best.hit = true;
+        best.t = t;
+        best.point = O + D * t;
+        best.segIndex = x;
+    }
+}
+
+// Эталон: луч против каждого отрезка диапазона
+static void castRayBruteForce(const std::vector<float>& terrain, Vec2 O, Vec2 D,
+                              int xMin, int xMax, float maxRange, RayHit& best)
+{
+    for (int x = xMin; x <= xMax; ++x) {
+        considerSegment(terrain, O, D, x, maxRange, best);
+    }
+}
+
+// Столбцы, которые луч проходит в пределах maxRange, в порядке обхода c0 -> c1
+struct ColumnSpan {
+    int step;
+    int c0, c1;
+    bool contains(int x) const { return step > 0 ? (x >= c0 && x <= c1) : (x <= c0 && x >= c1); }
+};
+
+static ColumnSpan rayColumns(Vec2 O, Vec2 D, int xMin, int xMax, float maxRange) {
+    ColumnSpan s;
+    s.step = (D.x >= 0.f) ? 1 : -1;
+    const float xEnd = O.x + D.x * maxRange;
+
+    // по столбцу запаса с каждой стороны: вершина под началом луча и округление в конце
+    s.c0 = (int)std::floor(O.x) - s.step;
+    s.c1 = (int)std::floor(xEnd) + s.step;
+    if (s.step > 0) { s.c0 = std::max(s.c0, xMin); s.c1 = std::min(s.c1, xMax); }
+    else            { s.c0 = std::min(s.c0, xMax); s.c1 = std::max(s.c1, xMin); }
+    return s;
+}
+
+// Кандидат other, найденный отдельным проходом, против best по тому же правилу
+static void mergeHit(RayHit& best, const RayHit& other) {
+    if (!other.hit) return;
+    if (!best.hit || other.t < best.t || (other.t == best.t && other.segIndex < best.segIndex)) {
+        best.hit = true;
+        best.t = other.t;
+        best.point = other.point;
+        best.segIndex = other.segIndex;
+    }
+}
+
+// Пачка столбцов на один вызов ядра — два его вектора, но не меньше 8; степень
+// двойки, чтобы пачки совпадали с блоками пирамиды. AVX2 получает по 16, SSE2 по 8
+static int kernelLeafLevel() {
+    static const int level = [] {
+        int level = 3;
+        while ((1 << level) < 2 * rayKernelLanes(raySegmentsKernelIsa())) ++level;
+        return level;
+    }();
+    return level;
+}
+
+// Проход по столбцам span в направлении луча. Интервалы t соседних столбцов идут
+// по возрастанию, поэтому первое найденное пересечение — ближайшее. Следующий столбец
+// проверяется дополнительно: на общей вершине оба отрезка дают одинаковый t.
+static void walkHeightfield(const std::vector<float>& terrain, Vec2 O, Vec2 D, ColumnSpan span,
+                            int xMin, int xMax, float maxRange, RayHit& best)
+{
+    const int step = span.step;
+
+    // столбцы идут пачками по ширине ядра; внутри пачки ядро само выбирает ближайший
+    const int chunk = 1 << kernelLeafLevel();
+    int x = span.c0;
+    while (span.contains(x)) {
+        int lo = (step > 0) ? x : std::max(x - chunk + 1, span.c1);
+        int hi = (step > 0) ? std::min(x + chunk - 1, span.c1) : x;
+        considerRange(terrain, O, D, lo, hi, maxRange, best);
+
+        int next = (step > 0) ? hi + 1 : lo - 1;
+        if (best.hit) {
+            if (next >= xMin && next <= xMax) considerSegment(terrain, O, D, next, maxRange, best);
+            return;
+        }
+        x = next;
+    }
+}
+
+// Тот же проход, но целые выровненные блоки отрезков пропускаются, если луч над
+// блоком проходит выше его самой высокой вершины. После пропуска уровень растёт
+// на единицу, при неудаче — спускается, так что путь по пустому небу логарифмический.
+static void walkPyramid(const std::vector<float>& terrain, const HeightPyramid& pyr,
+                        Vec2 O, Vec2 D, ColumnSpan span,
+                        int xMin, int xMax, float maxRange, RayHit& best)
+{
+    // почти вертикальный луч проходит пару столбцов, пирамида не нужна
+    if (std::abs(D.x) < 1e-6f) {
+        walkHeightfield(terrain, O, D, span, xMin, xMax, maxRange, best);
+        return;
+    }
+
+    const int step = span.step;
+    const int c1 = span.c1;
+    const float slope = D.y / D.x;
+    const float clearance = 1e-2f; // запас на погрешность пересечения
+
+    // прямая луча выше всех вершин блока [lo, hi] — пересечения нет
+    auto blockClear = [&](int level, int lo, int hi) {
+        float yA = O.y + ((float)lo - O.x) * slope;
+        float yB = O.y + ((float)(hi + 1) - O.x) * slope;
+        return std::max(yA, yB) < pyr.blockMinY(level, lo >> level) - clearance;
+    };
+
+    int level = 0;
+    int x = span.c0;
+    while (span.contains(x)) {
+        // наибольший уровень, блок которого начинается в x по ходу луча и не выходит за c1
+        int cap = 0;
+        while (cap + 1 < pyr.levels()) {
+            int size = 1 << (cap + 1);
+            bool fits = (step > 0) ? ((x & (size - 1)) == 0 && x + size - 1 <= c1)
+                                   : (((x + 1) & (size - 1)) == 0 && x - size + 1 >= c1);
+            if (!fits) break;
+            ++cap;
+        }
+        level = std::min(level + 1, cap);
+
+        for (; level > 0; --level) {
+            int size = 1 << level;
+            int lo = (step > 0) ? x : x - size + 1;
+            if (blockClear(level, lo, lo + size - 1)) break;
+        }
+        if (level > 0) {
+            x += step * (1 << level);
+            continue;
+        }
+
+        // до ближайшей границы пачки — дальше блоки снова выровнены
+        const int mask = (1 << kernelLeafLevel()) - 1;
+        int lo = (step > 0) ? x : std::max(x & ~mask, c1);
+        int hi = (step > 0) ? std::min(x | mask, c1) : x;
+        considerRange(terrain, O, D, lo, hi, maxRange, best);
+
+        int next = (step > 0) ? hi + 1 : lo - 1;
+        if (best.hit) {
+            if (next >= xMin && next <= xMax) considerSegment(terrain, O, D, next, maxRange, best);
+            return;
+        }
+        x = next;
+    }
+}
+
+static void walkColumns(const std::vector<float>& terrain, const HeightPyramid* pyr,
+                        Vec2 O, Vec2 D, ColumnSpan span,
+                        int xMin, int xMax, float maxRange, RayHit& best)
+{
+    if (pyr) walkPyramid(terrain, *pyr, O, D, span, xMin, xMax, maxRange, best);
+    else     walkHeightfield(terrain, O, D, span, xMin, xMax, maxRange, best);
+}
+
+// Луч не касается отрезков [lo, hi]. Диапазон раскладывается на выровненные блоки
+// пирамиды; блок, над которым прямая луча не проходит с запасом, делится пополам,
+// пачки ширины ядра проверяются им точно. Дробятся только места, где луч
+// подходит к рельефу вплотную, поэтому обычно это несколько проверок блоков.
+static bool rayClearOfRange(const std::vector<float>& terrain, const HeightPyramid& pyr,
+                            Vec2 O, Vec2 D, int lo, int hi, float maxRange)
+{
+    if (std::abs(D.x) < 1e-6f) return false;
+    const float slope = D.y / D.x;
+    const int leafLevel = kernelLeafLevel();
+
+    struct Block { int level, start; };
+    Block stack[64];
+    int top = 0;
+
+    // жадное разбиение [lo, hi] на выровненные блоки (как в HeightPyramid::minY)
+    for (int x = lo; x <= hi; ) {
+        int k = 0;
+        while (k + 1 < pyr.levels() && (x & ((1 << (k + 1)) - 1)) == 0 &&
+               x + (1 << (k + 1)) - 1 <= hi) ++k;
+
+        stack[top++] = {k, x};
+        while (top > 0) {
+            Block b = stack[--top];
+            int size = 1 << b.level;
+            float yA = O.y + ((float)b.start - O.x) * slope;
+            float yB = O.y + ((float)(b.start + size) - O.x) * slope;
+            if (std::max(yA, yB) < pyr.blockMinY(b.level, b.start >> b.level) - 1e-2f) continue;
+
+            if (b.level <= leafLevel) {
+                float t;
+                if (raySegmentsKernel()(terrain.data(), b.start, size, O, D, maxRange, t) >= 0) return false;
+                continue;
+            }
+            stack[top++] = {b.level - 1, b.start};
+            stack[top++] = {b.level - 1, b.start + size / 2};
+        }
+        x += 1 << k;
+    }
+    return true;
+}
+
+// Поиск от попадания прошлого шага: сначала окно вокруг seed. Если в окне есть
+// пересечение, остаётся убедиться, что до окна луч ничего не задел (по пирамиде,
+// а если её нет или проверка не прошла — честным проходом этого участка).
+// Если окно пусто — полный проход. Результат тот же, что у полного прохода.
+static void castRayCoherent(const std::vector<float>& terrain, const HeightPyramid* pyr,
+                            Vec2 O, Vec2 D, int seed,
+                            int xMin, int xMax, float maxRange, RayHit& best)
+{
+    ColumnSpan span = rayColumns(O, D, xMin, xMax, maxRange);
+    if (seed < 0 || !span.contains(seed)) {
+        walkColumns(terrain, pyr, O, D, span, xMin, xMax, maxRange, best);
+        return;
+    }
 
+    // окно — пачка ядра и столбец сверху
+    const int radius = (1 << kernelLeafLevel()) / 2;
+    int nearX = seed - span.step * radius;
+    int farX  = seed + span.step * radius;
+    if (!span.contains(nearX)) nearX = span.c0;
+    if (!span.contains(farX))  farX  = span.c1;
+
+    RayHit local = best;
+    considerRange(terrain, O, D, std::min(nearX, farX), std::max(nearX, farX), maxRange, local);
+    if (!local.hit) {
+        walkColumns(terrain, pyr, O, D, span, xMin, xMax, maxRange, best);
+        return;
+    }
+    // Дальше окна луч уходит дальше, но вершину дальнего края окна делит и
+    // следующий столбец: при step < 0 у него меньший индекс, и при равном t
+    // полный проход выбрал бы его
+    if (local.segIndex == farX && farX != span.c1) {
+        considerSegment(terrain, O, D, farX + span.step, maxRange, local);
+    }
+
+    if (nearX != span.c0) {
+        int before = nearX - span.step;
+        bool clear = pyr && rayClearOfRange(terrain, *pyr, O, D, std::min(span.c0, before),
+                                            std::max(span.c0, before), maxRange);
+        if (!clear) {
+            walkColumns(terrain, pyr, O, D, {span.step, span.c0, before}, xMin, xMax, maxRange, best);
+        }
+    }
+    mergeHit(best, local);
+}
+
+// Общий цикл по лучам: готовый луч i отдаётся в emit(i, hit). Лучи независимы и
+// пишутся по своему индексу, поэтому при разбиении на потоки результат тот же.
+template <typename Emit>
+static void scanRays(const std::vector<float>& terrain,
+                     const HeightPyramid* pyramid,
+                     Vec2 origin,
+                     float shipAngleRad,
+                     const RadarConfig& cfg,
+                     int* seeds,
+                     Emit emit)
+{
     // вниз в системе корабля
     Vec2 downWorld = rotate({0.f, 1.f}, shipAngleRad);
+    const float shipCos = downWorld.y, shipSin = -downWorld.x;
 
     int xMin = std::max(0, (int)std::floor(origin.x - cfg.maxXSpan));
     int xMax = std::min((int)terrain.size() - 2, (int)std::ceil(origin.x + cfg.maxXSpan));
 
-    hits.reserve((size_t)cfg.rays);
+    const Vec2* dirTable = cfg.shipFrameDirCount == cfg.rays ? cfg.shipFrameDirs : nullptr;
 
-    for (int i = 0; i < cfg.rays; ++i) {
-        float a = (cfg.rays == 1) ? 0.f : (float)i / (float)(cfg.rays - 1);
-        float ang = (-0.5f * cfg.fovRad) + a * cfg.fovRad;
+    auto scanRange = [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            Vec2 D;
+            if (dirTable) {
+                Vec2 d = dirTable[i];
+                D = {d.x * shipCos - d.y * shipSin, d.x * shipSin + d.y * shipCos};
+            } else {
+                float a = (cfg.rays == 1) ? 0.f : (float)i / (float)(cfg.rays - 1);
+                float ang = (-0.5f * cfg.fovRad) + a * cfg.fovRad;
 
-        Vec2 D = rotate(downWorld, ang);
-        D = norm(D);
+                D = rotate(downWorld, ang);
+                D = norm(D);
+            }
 
-        RayHit best;
-        best.origin = origin;
-        best.dir = D;
-        best.hit = false;
-        best.t = cfg.maxRange;
-        best.point = origin + D * best.t; // точка в конце луча, если не было попадания
+            RayHit best;
+            best.origin = origin;
+            best.dir = D;
+            best.hit = false;
+            best.t = cfg.maxRange;
+            best.point = origin + D * best.t; // точка в конце луча, если не было попадания
 
-        for (int x = xMin; x <= xMax; ++x) {
-            Vec2 A{(float)x, terrain[x]};
-            Vec2 B{(float)(x + 1), terrain[x + 1]};
+            if (cfg.traversal == RadarTraversal::BruteForce)
+                castRayBruteForce(terrain, origin, D, xMin, xMax, cfg.maxRange, best);
+            else if (seeds)
+                castRayCoherent(terrain, pyramid, origin, D, seeds[i], xMin, xMax, cfg.maxRange, best);
+            else
+                walkColumns(terrain, pyramid, origin, D, rayColumns(origin, D, xMin, xMax, cfg.maxRange),
+                            xMin, xMax, cfg.maxRange, best);
 
-            float t, u;
-            if (!raySegmentIntersect(origin, D, A, B, t, u)) continue;
-            if (t > cfg.maxRange) continue;
+            if (seeds) seeds[i] = best.segIndex;
 
-            if (!best.hit || t < best.t) {
-                best.hit = true;
-                best.t = t;
-                best.point = origin + D * t;
-                best.segIndex = x;
-            }
+            emit(i, best);
         }
+    };
 
-        hits.push_back(best);
+    if (cfg.parallelMinRays > 0 && cfg.rays >= cfg.parallelMinRays) {
+        WorkerPool::shared().parallelFor(cfg.rays, 64, scanRange);
+    } else {
+        scanRange(0, cfg.rays);
     }
+}
+
+static std::vector<RayHit> scanRadarImpl(const std::vector<float>& terrain,
+                                         const HeightPyramid* pyramid,
+                                         Vec2 origin,
+                                         float shipAngleRad,
+                                         const RadarConfig& cfg,
+                                         int* seeds)
+{
+    std::vector<RayHit> hits;
+    if (terrain.size() < 2 || cfg.rays <= 0) return hits;
 
+    hits.resize((size_t)cfg.rays);
+    scanRays(terrain, pyramid, origin, shipAngleRad, cfg, seeds,
+             [&](int i, const RayHit& h) { hits[i] = h; });
     return hits;
 }
+
+static void scanRadarImpl(const std::vector<float>& terrain,
+                          const HeightPyramid* pyramid,
+                          Vec2 origin,
+                          float shipAngleRad,
+                          const RadarConfig& cfg,
+                          int* seeds,
+                          RadarHitBuffer& out)
+{
+    out.origin = origin;
+    if (terrain.size() < 2 || cfg.rays <= 0) { out.resize(0); return; }
+
+    out.resize(cfg.rays);
+    scanRays(terrain, pyramid, origin, shipAngleRad, cfg, seeds,
+             [&](int i, const RayHit& h) {
+                 out.t[i] = h.t;
+                 out.px[i] = h.point.x;
+                 out.py[i] = h.point.y;
+                 out.segIndex[i] = h.segIndex;
+                 out.hit[i] = h.hit ? 1 : 0;
+             });
+}
+
+// Пирамида от другого рельефа хуже, чем никакой
+static const HeightPyramid* usablePyramid(const std::vector<float>& terrain, const HeightPyramid& pyramid) {
+    return (pyramid.segments() + 1 == (int)terrain.size()) ? &pyramid : nullptr;
+}
+
+void RadarHitBuffer::resize(int n) {
+    size_t m = (size_t)std::max(n, 0);
+    t.resize(m);
+    px.resize(m);
+    py.resize(m);
+    segIndex.resize(m);
+    hit.resize(m);
+}
+
+std::vector<RayHit> scanRadar(const std::vector<float>& terrain,
+                              Vec2 origin,
+                              float shipAngleRad,
+                              const RadarConfig& cfg)
+{
+    return scanRadarImpl(terrain, nullptr, origin, shipAngleRad, cfg, nullptr);
+}
+
+std::vector<RayHit> scanRadar(const std::vector<float>& terrain,
+                              const HeightPyramid& pyramid,
+                              Vec2 origin,
+                              float shipAngleRad,
+                              const RadarConfig& cfg)
+{
+    return scanRadarImpl(terrain, usablePyramid(terrain, pyramid), origin, shipAngleRad, cfg, nullptr);
+}
+
+void scanRadar(const std::vector<float>& terrain,
+               Vec2 origin,
+               float shipAngleRad,
+               const RadarConfig& cfg,
+               RadarHitBuffer& out)
+{
+    scanRadarImpl(terrain, nullptr, origin, shipAngleRad, cfg, nullptr, out);
+}
+
+void scanRadar(const std::vector<float>& terrain,
+               const HeightPyramid& pyramid,
+               Vec2 origin,
+               float shipAngleRad,
+               const RadarConfig& cfg,
+               RadarHitBuffer& out)
+{
+    scanRadarImpl(terrain, usablePyramid(terrain, pyramid), origin, shipAngleRad, cfg, nullptr, out);
+}
+
+void RadarScanner::reset() {
+    seeds.clear();
+}
+
+int* RadarScanner::seedsFor(const RadarConfig& cfg) {
+    if ((int)seeds.size() != cfg.rays) seeds.assign((size_t)std::max(cfg.rays, 0), -1);
+    return (cfg.traversal == RadarTraversal::BruteForce) ? nullptr : seeds.data();
+}
+
+std::vector<RayHit> RadarScanner::scan(const std::vector<float>& terrain,
+                                       const HeightPyramid& pyramid,
+                                       Vec2 origin,
+                                       float shipAngleRad,
+                                       const RadarConfig& cfg)
+{
+    return scanRadarImpl(terrain, usablePyramid(terrain, pyramid), origin, shipAngleRad, cfg,
+                         seedsFor(cfg));
+}
+
+void RadarScanner::scan(const std::vector<float>& terrain,
+                        const HeightPyramid& pyramid,
+                        Vec2 origin,
+                        float shipAngleRad,
+                        const RadarConfig& cfg,
+                        RadarHitBuffer& out)
+{
+    scanRadarImpl(terrain, usablePyramid(terrain, pyramid), origin, shipAngleRad, cfg,
+                  seedsFor(cfg), out);
+}
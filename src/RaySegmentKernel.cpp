@@ -0,0 +1,242 @@
+#include "RaySegmentKernel.h"
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define LANDER_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define LANDER_TARGET(isa)
+    #else
+        #define LANDER_TARGET(isa) __attribute__((target(isa)))
+    #endif
+#else
+    #define LANDER_X86 0
+#endif
+
+static const float kInf = std::numeric_limits<float>::infinity();
+
+// Та же арифметика, что в raySegmentIntersect при B.x - A.x == 1
+int raySegmentsScalar(const float* terrain, int x0, int count,
+                      Vec2 O, Vec2 D, float maxRange, float& outT)
+{
+    int bestX = -1;
+    float bestT = kInf;
+    for (int i = 0; i < count; ++i) {
+        int x = x0 + i;
+        float h0 = terrain[x];
+        float vy = terrain[x + 1] - h0;
+        float den = D.x * vy - D.y;
+        if (std::abs(den) < 1e-8f) continue;
+
+        float wx = O.x - (float)x;
+        float wy = O.y - h0;
+        float t = (wy - vy * wx) / den;
+        float u = (D.x * wy - D.y * wx) / den;
+        if (!(t >= 0.f && u >= 0.f && u <= 1.f && t <= maxRange)) continue;
+
+        if (t < bestT) { bestT = t; bestX = x; }
+    }
+    if (bestX >= 0) outT = bestT;
+    return bestX;
+}
+
+#if LANDER_X86
+
+// Свёртка лучших значений по дорожкам: меньший t, при равенстве — меньший индекс
+static int reduceLanes(const float* t, const float* x, int lanes, float& outT) {
+    int bestX = -1;
+    float bestT = kInf;
+    for (int k = 0; k < lanes; ++k) {
+        if (x[k] < 0.f) continue;
+        int xi = (int)x[k];
+        if (t[k] < bestT || (t[k] == bestT && xi < bestX)) { bestT = t[k]; bestX = xi; }
+    }
+    if (bestX >= 0) outT = bestT;
+    return bestX;
+}
+
+// Хвост, не кратный ширине вектора, досчитывается скалярно
+static int mergeTail(int bestX, float& bestT, const float* terrain, int x0, int done, int count,
+                     Vec2 O, Vec2 D, float maxRange)
+{
+    if (done >= count) return bestX;
+    float tailT;
+    int tailX = raySegmentsScalar(terrain, x0 + done, count - done, O, D, maxRange, tailT);
+    if (tailX >= 0 && (bestX < 0 || tailT < bestT)) { bestT = tailT; return tailX; }
+    return bestX;
+}
+
+LANDER_TARGET("avx2")
+static int raySegmentsAvx2(const float* terrain, int x0, int count,
+                           Vec2 O, Vec2 D, float maxRange, float& outT)
+{
+    const __m256 ox = _mm256_set1_ps(O.x), oy = _mm256_set1_ps(O.y);
+    const __m256 dx = _mm256_set1_ps(D.x), dy = _mm256_set1_ps(D.y);
+    const __m256 maxR = _mm256_set1_ps(maxRange);
+    const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.f);
+    const __m256 eps = _mm256_set1_ps(1e-8f);
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    const __m256 lane = _mm256_setr_ps(0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f);
+
+    __m256 bestT = _mm256_set1_ps(kInf);
+    __m256 bestX = _mm256_set1_ps(-1.f);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        int x = x0 + i;
+        __m256 h0 = _mm256_loadu_ps(terrain + x);
+        __m256 h1 = _mm256_loadu_ps(terrain + x + 1);
+        __m256 vy = _mm256_sub_ps(h1, h0);
+        __m256 den = _mm256_sub_ps(_mm256_mul_ps(dx, vy), dy);
+
+        __m256 xf = _mm256_add_ps(_mm256_set1_ps((float)x), lane);
+        __m256 wx = _mm256_sub_ps(ox, xf);
+        __m256 wy = _mm256_sub_ps(oy, h0);
+        __m256 t = _mm256_div_ps(_mm256_sub_ps(wy, _mm256_mul_ps(vy, wx)), den);
+        __m256 u = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(dx, wy), _mm256_mul_ps(dy, wx)), den);
+
+        __m256 ok = _mm256_cmp_ps(_mm256_and_ps(den, absMask), eps, _CMP_GE_OQ);
+        ok = _mm256_and_ps(ok, _mm256_cmp_ps(t, zero, _CMP_GE_OQ));
+        ok = _mm256_and_ps(ok, _mm256_cmp_ps(u, zero, _CMP_GE_OQ));
+        ok = _mm256_and_ps(ok, _mm256_cmp_ps(u, one, _CMP_LE_OQ));
+        ok = _mm256_and_ps(ok, _mm256_cmp_ps(t, maxR, _CMP_LE_OQ));
+
+        __m256 better = _mm256_and_ps(ok, _mm256_cmp_ps(t, bestT, _CMP_LT_OQ));
+        bestT = _mm256_blendv_ps(bestT, t, better);
+        bestX = _mm256_blendv_ps(bestX, xf, better);
+    }
+
+    alignas(32) float lt[8], lx[8];
+    _mm256_store_ps(lt, bestT);
+    _mm256_store_ps(lx, bestX);
+    float t = kInf;
+    int best = reduceLanes(lt, lx, 8, t);
+    best = mergeTail(best, t, terrain, x0, i, count, O, D, maxRange);
+    if (best >= 0) outT = t;
+    return best;
+}
+
+// Только SSE2: он есть на любом x86-64, поэтому смешивание через and/andnot
+LANDER_TARGET("sse2")
+static int raySegmentsSse(const float* terrain, int x0, int count,
+                          Vec2 O, Vec2 D, float maxRange, float& outT)
+{
+    const __m128 ox = _mm_set1_ps(O.x), oy = _mm_set1_ps(O.y);
+    const __m128 dx = _mm_set1_ps(D.x), dy = _mm_set1_ps(D.y);
+    const __m128 maxR = _mm_set1_ps(maxRange);
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.f);
+    const __m128 eps = _mm_set1_ps(1e-8f);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 lane = _mm_setr_ps(0.f, 1.f, 2.f, 3.f);
+
+    __m128 bestT = _mm_set1_ps(kInf);
+    __m128 bestX = _mm_set1_ps(-1.f);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        int x = x0 + i;
+        __m128 h0 = _mm_loadu_ps(terrain + x);
+        __m128 h1 = _mm_loadu_ps(terrain + x + 1);
+        __m128 vy = _mm_sub_ps(h1, h0);
+        __m128 den = _mm_sub_ps(_mm_mul_ps(dx, vy), dy);
+
+        __m128 xf = _mm_add_ps(_mm_set1_ps((float)x), lane);
+        __m128 wx = _mm_sub_ps(ox, xf);
+        __m128 wy = _mm_sub_ps(oy, h0);
+        __m128 t = _mm_div_ps(_mm_sub_ps(wy, _mm_mul_ps(vy, wx)), den);
+        __m128 u = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(dx, wy), _mm_mul_ps(dy, wx)), den);
+
+        __m128 ok = _mm_cmpge_ps(_mm_and_ps(den, absMask), eps);
+        ok = _mm_and_ps(ok, _mm_cmpge_ps(t, zero));
+        ok = _mm_and_ps(ok, _mm_cmpge_ps(u, zero));
+        ok = _mm_and_ps(ok, _mm_cmple_ps(u, one));
+        ok = _mm_and_ps(ok, _mm_cmple_ps(t, maxR));
+
+        __m128 better = _mm_and_ps(ok, _mm_cmplt_ps(t, bestT));
+        bestT = _mm_or_ps(_mm_and_ps(better, t), _mm_andnot_ps(better, bestT));
+        bestX = _mm_or_ps(_mm_and_ps(better, xf), _mm_andnot_ps(better, bestX));
+    }
+
+    alignas(16) float lt[4], lx[4];
+    _mm_store_ps(lt, bestT);
+    _mm_store_ps(lx, bestX);
+    float t = kInf;
+    int best = reduceLanes(lt, lx, 4, t);
+    best = mergeTail(best, t, terrain, x0, i, count, O, D, maxRange);
+    if (best >= 0) outT = t;
+    return best;
+}
+
+static bool cpuSupports(RayKernelIsa isa) {
+    if (isa == RayKernelIsa::Scalar) return true;
+#if defined(_MSC_VER) && !defined(__clang__)
+    int r[4];
+    __cpuid(r, 1);
+    bool sse2 = (r[3] & (1 << 26)) != 0;
+    bool osxsave = (r[2] & (1 << 27)) != 0;
+    bool avx = (r[2] & (1 << 28)) != 0;
+    if (isa == RayKernelIsa::Sse) return sse2;
+
+    // AVX-регистры должен сохранять и сам ОС
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;
+    __cpuid(r, 0);
+    if (r[0] < 7) return false;
+    __cpuidex(r, 7, 0);
+    return (r[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    if (isa == RayKernelIsa::Sse) return __builtin_cpu_supports("sse2");
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#else
+
+static bool cpuSupports(RayKernelIsa isa) { return isa == RayKernelIsa::Scalar; }
+
+#endif
+
+RaySegmentsFn raySegmentsKernelFor(RayKernelIsa isa) {
+    if (!cpuSupports(isa)) return nullptr;
+    switch (isa) {
+#if LANDER_X86
+        case RayKernelIsa::Avx2: return raySegmentsAvx2;
+        case RayKernelIsa::Sse:  return raySegmentsSse;
+#endif
+        case RayKernelIsa::Scalar: return raySegmentsScalar;
+        default: return nullptr;
+    }
+}
+
+RayKernelIsa raySegmentsKernelIsa() {
+    static const RayKernelIsa isa = [] {
+        if (cpuSupports(RayKernelIsa::Avx2)) return RayKernelIsa::Avx2;
+        if (cpuSupports(RayKernelIsa::Sse))  return RayKernelIsa::Sse;
+        return RayKernelIsa::Scalar;
+    }();
+    return isa;
+}
+
+RaySegmentsFn raySegmentsKernel() {
+    static const RaySegmentsFn fn = raySegmentsKernelFor(raySegmentsKernelIsa());
+    return fn;
+}
+
+const char* rayKernelIsaName(RayKernelIsa isa) {
+    switch (isa) {
+        case RayKernelIsa::Avx2:   return "AVX2";
+        case RayKernelIsa::Sse:    return "SSE2";
+        case RayKernelIsa::Scalar: return "scalar";
+        default:                   return "?";
+    }
+}
+
+int rayKernelLanes(RayKernelIsa isa) {
+    switch (isa) {
+        case RayKernelIsa::Avx2: return 8;
+        case RayKernelIsa::Sse:  return 4;
+        default:                 return 1;
+    }
+}
@@ -0,0 +1,234 @@
+#include "SimThread.h"
+#include "Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+SimThread::SimThread() {
+    rateStart = Clock::now();
+    restartMission();
+    tick();
+    publish();
+}
+
+SimThread::~SimThread() {
+    stop();
+}
+
+void SimThread::start() {
+    if (running.exchange(true)) return;
+    worker = std::thread([this] { run(); });
+}
+
+void SimThread::stop() {
+    running.store(false, std::memory_order_release);
+    if (worker.joinable()) worker.join();
+}
+
+void SimThread::run() {
+    Trace::setThreadName("sim");
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(Config::DT));
+    const auto publishPeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / TURBO_PUBLISH_HZ));
+
+    auto next = Clock::now();
+    while (running.load(std::memory_order_acquire)) {
+        // у законченной миссии турбо ничего не даёт, кроме горячего ядра
+        if (turbo && !paused && !sim.finished()) {
+            turboBurst(Clock::now() + publishPeriod);
+            measureRate();
+            if (dirty) publish();
+            next = Clock::now();
+            continue;
+        }
+
+        tick();
+        measureRate();
+        if (dirty) publish();
+
+        next += period;
+        auto now = Clock::now();
+        // сильно отстали (отладчик, спящий ноутбук) — не догоняем рывком
+        if (now - next > period * 4) next = now;
+        std::this_thread::sleep_until(next);
+    }
+}
+
+void SimThread::restartMission() {
+    landingFoundShown = false;
+    foundMsgTimer = 0.0f;
+    timeAcc = 0.0f;
+    wind = {0.0f, 0.0f};
+
+    int seed = std::rand();
+    float startX = 100.0f + (std::rand() % (Config::WINDOW_WIDTH - 200));
+    sim.reset(seed, startX);
+    pausedScanValid = false;
+}
+
+void SimThread::apply(SimCommand cmd) {
+    dirty = true;
+    switch (cmd) {
+    case SimCommand::TogglePause: paused = !paused; break;
+    case SimCommand::Restart:     restartMission(); break;
+    case SimCommand::ToggleAuto:  autoMode = !autoMode; break;
+    case SimCommand::ResetWind:   wind = {0.0f, 0.0f}; break;
+    case SimCommand::SlowDown:    timeScale = std::max(0.25f, timeScale * 0.5f); break;
+    case SimCommand::SpeedUp:     timeScale = std::min(4.0f, timeScale * 2.0f); break;
+    case SimCommand::SwapGimbals: std::swap(leftGimbal, rightGimbal); break;
+    case SimCommand::ZeroGimbals: leftGimbal = 0.0f; rightGimbal = 0.0f; break;
+    case SimCommand::GimbalLeft:  gimbalMode = 1; break;
+    case SimCommand::GimbalRight: gimbalMode = 2; break;
+    case SimCommand::GimbalBoth:  gimbalMode = 3; break;
+    case SimCommand::ToggleTurbo: turbo = !turbo; timeAcc = 0.0f; break;
+    case SimCommand::ToggleUnbounded:
+        sim.unboundedTerrain = !sim.unboundedTerrain;
+        restartMission();
+        break;
+    }
+}
+
+// true, если ветер изменился
+bool SimThread::updateWind(std::uint32_t keys) {
+    const float windRate = Config::WIND_RATE;
+    const float windMax = Config::WIND_MAX;
+    Vec2 dv{0.0f, 0.0f};
+    if (keys & HeldKey::WindUp)    dv.y -= windRate * Config::DT;
+    if (keys & HeldKey::WindDown)  dv.y += windRate * Config::DT;
+    if (keys & HeldKey::WindLeft)  dv.x -= windRate * Config::DT;
+    if (keys & HeldKey::WindRight) dv.x += windRate * Config::DT;
+    if (dv.x == 0.0f && dv.y == 0.0f) return false;
+
+    wind.x += dv.x;
+    wind.y += dv.y;
+    float L = std::sqrt(wind.x * wind.x + wind.y * wind.y);
+    if (L > windMax && L > 1e-6f) {
+        wind.x = wind.x / L * windMax;
+        wind.y = wind.y / L * windMax;
+    }
+    return true;
+}
+
+ControlOutput SimThread::manualControl(std::uint32_t keys) {
+    ControlOutput ctrl{};
+    if (keys & HeldKey::MainThrust)  ctrl.mainThrust = 1.0f;
+    if (keys & HeldKey::RightThrust) ctrl.rightThrust = 1.0f;
+    if (keys & HeldKey::LeftThrust)  ctrl.leftThrust = 1.0f;
+
+    const float gimbalSpeed = 2.5f;
+    const float maxGimbal   = 0.8f;
+
+    if (keys & HeldKey::GimbalUp) {
+        leftGimbal  += gimbalSpeed * Config::DT;
+        rightGimbal += gimbalSpeed * Config::DT;
+    }
+    if (keys & HeldKey::GimbalDown) {
+        leftGimbal  -= gimbalSpeed * Config::DT;
+        rightGimbal -= gimbalSpeed * Config::DT;
+    }
+
+    if (keys & HeldKey::GimbalQ) {
+        if (gimbalMode == 1) leftGimbal -= gimbalSpeed * Config::DT;
+        else if (gimbalMode == 2) rightGimbal -= gimbalSpeed * Config::DT;
+        else { leftGimbal -= gimbalSpeed * Config::DT; rightGimbal += gimbalSpeed * Config::DT; }
+    }
+    if (keys & HeldKey::GimbalE) {
+        if (gimbalMode == 1) leftGimbal += gimbalSpeed * Config::DT;
+        else if (gimbalMode == 2) rightGimbal += gimbalSpeed * Config::DT;
+        else { leftGimbal += gimbalSpeed * Config::DT; rightGimbal -= gimbalSpeed * Config::DT; }
+    }
+
+    leftGimbal  = std::clamp(leftGimbal,  -maxGimbal, maxGimbal);
+    rightGimbal = std::clamp(rightGimbal, -maxGimbal, maxGimbal);
+    ctrl.leftGimbal  = leftGimbal;
+    ctrl.rightGimbal = rightGimbal;
+    return ctrl;
+}
+
+void SimThread::stepOnce(std::uint32_t keys) {
+    sim.setWind(wind);
+    if (autoMode) sim.step();
+    else sim.step(manualControl(keys));
+    ++stepsDone;
+    dirty = true;
+    pausedScanValid = false;
+
+    if (foundMsgTimer > 0.0f) foundMsgTimer -= Config::DT;
+    if (!landingFoundShown && autoMode && sim.hasLandingTarget()) {
+        landingFoundShown = true;
+        foundMsgTimer = 5.0f;
+    }
+}
+
+std::uint32_t SimThread::pollInput() {
+    SimCommand cmd;
+    while (commands.pop(cmd)) apply(cmd);
+
+    std::uint32_t keys = heldKeys.load(std::memory_order_relaxed);
+    if (updateWind(keys)) dirty = true;
+    return keys;
+}
+
+void SimThread::tick() {
+    std::uint32_t keys = pollInput();
+
+    if (!paused) {
+        timeAcc += timeScale;
+        while (timeAcc >= 1.0f) {
+            stepOnce(keys);
+            timeAcc -= 1.0f;
+        }
+    } else if (!pausedScanValid) {
+        // на паузе аппарат стоит: скан один на положение, а не на каждый тик
+        sim.scanRadarAt(0.0f);
+        pausedScanValid = true;
+        dirty = true;
+    }
+}
+
+void SimThread::turboBurst(Clock::time_point until) {
+    std::uint32_t keys = pollInput();
+    // часы дороже шага не в разы, но и не бесплатны — смотрим раз на пачку
+    const int stepsPerCheck = 64;
+    while (turbo && !paused && !sim.finished() && Clock::now() < until) {
+        for (int k = 0; k < stepsPerCheck && !sim.finished(); ++k) stepOnce(keys);
+    }
+}
+
+void SimThread::measureRate() {
+    auto now = Clock::now();
+    double elapsed = std::chrono::duration<double>(now - rateStart).count();
+    if (elapsed < 0.5) return;
+    float rate = (float)((stepsDone - rateSteps) / elapsed);
+    if (rate != stepsPerSecond) dirty = true;
+    stepsPerSecond = rate;
+    rateSteps = stepsDone;
+    rateStart = now;
+}
+
+void SimThread::publish() {
+    SimSnapshot& s = snapshots.back();
+    s.state = sim.getState();
+    // версия меняется и при сдвиге окна в мире без краёв
+    if (s.terrainVersion != sim.terrainVersion()) {
+        s.terrain = sim.getTerrain();
+        s.terrainOrigin = sim.terrainOrigin();
+        s.terrainVersion = sim.terrainVersion();
+    }
+    s.unbounded = sim.chunkedTerrain() != nullptr;
+    s.radarHits = sim.getRadarHits();   // после первых кадров — без выделений
+    s.hasTargetSite = sim.hasLandingTarget();
+    if (s.hasTargetSite) s.targetSite = sim.getLandingTarget();
+    s.phaseName = sim.getPhaseName();
+
+    s.autoMode = autoMode;
+    s.paused = paused;
+    s.foundMsgTimer = foundMsgTimer;
+    s.wind = wind;
+    s.timeScale = timeScale;
+    s.gimbalMode = gimbalMode;
+    s.turbo = turbo;
+    s.stepsPerSecond = stepsPerSecond;
+    snapshots.publish();
+    dirty = false;
+}
@@ -0,0 +1,135 @@
+#include "Simulation.h"
+#include "FixedRadar.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+Simulation::Simulation() {
+    radarCfg = DefaultRadar::config();
+    detCfg.maxSlope = std::tan(Config::MAX_LANDING_ANGLE_RAD);
+    detCfg.maxBandY = std::max(detCfg.maxBandY, detCfg.maxSlope * detCfg.minLenX);
+}
+
+void Simulation::reset(int seed, float startX) {
+    autopilot.reset();
+    wind = {0.0f, 0.0f};
+    physics.setWind(wind);
+
+    if (unboundedTerrain) {
+        if (!world) world = std::make_unique<ChunkedTerrain>(32, terrainPrefetch);
+        world->reset(seed);
+        moveWindow(ChunkedTerrain::chunkOf(startX) - WINDOW_CHUNKS / 2, 0);
+    } else {
+        ProfileScope probe(ProfileStage::TerrainGen);
+        world.reset();
+        terrain = terrainGen.generate(Config::WINDOW_WIDTH, seed);
+        terrainX0 = 0;
+        pyramid.build(terrain);
+        ++terrainVer;
+    }
+    radar.reset();
+    radarHits.resize(0);
+
+    physics.init(startX, 50.0f, 500.0f, {100.0f, 100.0f});
+    state = physics.getState();
+    steps = 0;
+}
+
+void Simulation::step() {
+    advance(nullptr);
+}
+
+void Simulation::step(const ControlOutput& manual) {
+    advance(&manual);
+}
+
+void Simulation::advance(const ControlOutput* manual) {
+    ProfileScope stepProbe(ProfileStage::SimStep);
+    physics.setWind(wind);
+
+    if (world) followRover();
+    float terrainH = groundAt(state.x);
+
+    {
+        ProfileScope probe(ProfileStage::RadarScan);
+        scanWindow(state.angle, true);
+    }
+
+    // площадки нужны, только пока цель не выбрана
+    if (!autopilot.hasLandingTarget()) {
+        ProfileScope probe(ProfileStage::DetectSites);
+        const auto& sites = detectLandingSites(radarHits, state.x, detCfg, detScratch);
+        LandingSite bestSite{};
+        if (pickBestSite(sites, bestSite)) autopilot.setLandingTarget(bestSite);
+    }
+
+    ControlOutput ctrl;
+    if (manual) {
+        ctrl = *manual;
+    } else {
+        ProfileScope probe(ProfileStage::Controller);
+        const char* phaseBefore = autopilot.getPhaseName();
+        ctrl = autopilot.compute(state, radarHits);
+        // смена фазы автопилота — отметка в трассе
+        const char* phase = autopilot.getPhaseName();
+        if (phase != phaseBefore && Trace::enabled()) Trace::instant(phase, "phase");
+    }
+
+    {
+        ProfileScope probe(ProfileStage::Physics);
+        physics.update(ctrl, terrainH);
+    }
+    state = physics.getState();
+    ++steps;
+}
+
+void Simulation::scanRadarAt(float shipAngleRad) {
+    ProfileScope probe(ProfileStage::RadarScan);
+    scanWindow(shipAngleRad, false);
+}
+
+float Simulation::groundAt(float x) const {
+    int tIdx = std::clamp((int)(x - (float)terrainX0), 0, (int)terrain.size() - 1);
+    return terrain[tIdx];
+}
+
+void Simulation::moveWindow(int first, int dir) {
+    ProfileScope probe(ProfileStage::TerrainGen);
+    world->assemble(first, WINDOW_CHUNKS, terrain);
+    terrainX0 = first * ChunkedTerrain::CHUNK_WIDTH;
+    pyramid.build(terrain);
+    radar.reset();      // запомненные отрезки лучей — в координатах старого окна
+    ++terrainVer;
+
+    // следующие соседи окна и ещё один кусок по ходу полёта
+    int next[3] = {first - 1, first + WINDOW_CHUNKS, 0};
+    int count = 2;
+    if (dir > 0) next[count++] = first + WINDOW_CHUNKS + 1;
+    if (dir < 0) next[count++] = first - 2;
+    world->prefetch(next, count);
+}
+
+void Simulation::followRover() {
+    // Середина окна — кусок first + 2. Сдвиг, когда корабль ушёл от неё на полкуска:
+    // так на границе кусков окно не пересобирается туда-обратно, а до края
+    // окна остаётся не меньше полутора кусков (дальность радара меньше)
+    const float w = (float)ChunkedTerrain::CHUNK_WIDTH;
+    float local = state.x - (float)terrainX0;
+    float mid = (WINDOW_CHUNKS / 2) * w;
+    if (local >= mid - 0.5f * w && local < mid + 1.5f * w) return;
+    moveWindow(ChunkedTerrain::chunkOf(state.x) - WINDOW_CHUNKS / 2, state.vx > 0.0f ? 1 : -1);
+}
+
+void Simulation::scanWindow(float shipAngleRad, bool tracked) {
+    Vec2 origin{state.x - (float)terrainX0, state.y};
+    if (tracked) radar.scan(terrain, pyramid, origin, shipAngleRad, radarCfg, radarHits);
+    else scanRadar(terrain, pyramid, origin, shipAngleRad, radarCfg, radarHits);
+    if (terrainX0 == 0) return;
+
+    const float dx = (float)terrainX0;
+    radarHits.origin.x = state.x;
+    for (int i = 0; i < radarHits.size(); ++i) {
+        radarHits.px[i] += dx;
+        if (radarHits.segIndex[i] >= 0) radarHits.segIndex[i] += terrainX0;
+    }
+}
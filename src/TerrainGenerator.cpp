@@ -1,112 +1,202 @@
 #include "TerrainGenerator.h"
-#include "FastNoiseLite.h"
+#include "NoiseBatch.h"
+#include "WorkerPool.h"
 #include <cstdlib>
 #include <algorithm>
 #include <cmath>
+#include <random>
+
+// Проход скользящего среднего src -> dst по столбцам [begin, end) бегущей
+// суммой: на столбец одно сложение и одно вычитание. Сумма копится в double:
+// на длинном куске в float набегает ошибка. Края шириной radius не
+// сглаживаются и копируются как есть.
+static void boxPass(const float* src, float* dst, int width, int radius, int begin, int end) {
+    const int lo = std::max(begin, radius);
+    const int hi = std::min(end, width - radius);
+    if (lo >= hi) {
+        std::copy(src + begin, src + end, dst + begin);
+        return;
+    }
+    std::copy(src + begin, src + lo, dst + begin);
+    std::copy(src + hi, src + end, dst + hi);
+
+    const double norm = 2.0 * radius + 1.0;
+    double sum = 0.0;
+    for (int k = lo - radius; k <= lo + radius; ++k) sum += src[k];
+    dst[lo] = (float)(sum / norm);
+    for (int x = lo + 1; x < hi; ++x) {
+        sum += (double)src[x + radius] - (double)src[x - radius - 1];
+        dst[x] = (float)(sum / norm);
+    }
+}
 
-std::vector<float> TerrainGenerator::generate(int width, int seed) {
-    std::vector<float> terrain(width);
-    std::srand(seed);
-
-    auto clampf = [](float v, float a, float b) { return std::max(a, std::min(v, b)); };
-    auto lerp   = [](float a, float b, float t) { return a + (b - a) * t; };
-    auto smoothstep01 = [&](float t) {
-        t = clampf(t, 0.0f, 1.0f);
-        return t * t * (3.0f - 2.0f * t); 
-    };
-
-
-    // Шум FastNoiseLite
-    FastNoiseLite noise;
-    noise.SetSeed(seed);
-    noise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
-    noise.SetFractalType(FastNoiseLite::FractalType_FBm);
-    noise.SetFractalOctaves(3);
-    noise.SetFractalLacunarity(2.0f);
-    noise.SetFractalGain(0.4f);
-    noise.SetFrequency(0.002f);
+static float clampf(float v, float a, float b) { return std::max(a, std::min(v, b)); }
+static float lerp(float a, float b, float t) { return a + (b - a) * t; }
+static float smoothstep01(float t) {
+    t = clampf(t, 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+static const int ZONE_WIDTH = 60;
+static const int ZONE_BLEND = 30;
+
+// Сколько столбцов с каждого края портят passes проходов радиуса radius
+static int smoothReach(int radius, int passes) {
+    return (radius > 0 && passes > 0) ? radius * passes : 0;
+}
+
+// passes проходов сглаживания; tmp — единственный рабочий буфер, после
+// прохода буферы меняются местами без копирования. Пул делит не столбцы,
+// а целые CHUNK: сумма заводится заново с одних и тех же столбцов при
+// любом числе потоков
+static void smooth(WorkerPool& workers, std::vector<float>& terrain, std::vector<float>& tmp,
+                   int radius, int passes)
+{
+    if (radius <= 0) return;
+    const int width = (int)terrain.size();
+    const int CHUNK = TerrainGenerator::CHUNK;
+    const int chunks = (width + CHUNK - 1) / CHUNK;
+    tmp.resize(terrain.size());
+    for (int pass = 0; pass < passes; ++pass) {
+        workers.parallelFor(chunks, 1, [&](int first, int last) {
+            for (int c = first; c < last; ++c) {
+                boxPass(terrain.data(), tmp.data(), width, radius,
+                        c * CHUNK, std::min(width, (c + 1) * CHUNK));
+            }
+        });
+        terrain.swap(tmp);
+    }
+}
+
+// Шум OpenSimplex2 + FBm, как у FastNoiseLite, но пачками по NOISE_BLOCK точек.
+// terrain[i] — столбец мира x0 + i: шум зависит только от x, поэтому соседние
+// куски бесконечного рельефа сходятся без шва
+static void fillNoise(WorkerPool& workers, std::vector<float>& terrain, int x0, int seed) {
+    NoiseFbmConfig hills;
+    hills.seed = seed;
+    hills.octaves = 3;
+    hills.lacunarity = 2.0f;
+    hills.gain = 0.4f;
+    hills.frequency = 0.002f;
 
     const float baseY = Config::WINDOW_HEIGHT * 0.75f;
     const float mountainScale = 140.0f;
 
-    for (int x = 0; x < width; ++x) {
-        float n = noise.GetNoise((float)x, 0.0f);
-
-        // Основной рельеф
-        terrain[x] = baseY - (n * mountainScale);
+    const int NOISE_BLOCK = 256;
+    workers.parallelFor((int)terrain.size(), TerrainGenerator::CHUNK, [&](int begin, int end) {
+        float xs[NOISE_BLOCK], ys[NOISE_BLOCK], n[NOISE_BLOCK], pebbles[NOISE_BLOCK];
+        for (int b = begin; b < end; b += NOISE_BLOCK) {
+            int count = std::min(NOISE_BLOCK, end - b);
 
-        float pebbles = noise.GetNoise((float)x * 15.0f, 100.0f) * 1.5f;
-        terrain[x] += pebbles;
+            // Основной рельеф
+            for (int k = 0; k < count; ++k) { xs[k] = (float)(x0 + b + k); ys[k] = 0.0f; }
+            noiseFbmBatch(hills, xs, ys, n, count);
 
-        terrain[x] = clampf(terrain[x], 100.0f, (float)Config::WINDOW_HEIGHT - 20.0f);
-    }
+            // Мелкие камни: тот же шум в другом месте и масштабе
+            for (int k = 0; k < count; ++k) { xs[k] = (float)(x0 + b + k) * 15.0f; ys[k] = 100.0f; }
+            noiseFbmBatch(hills, xs, ys, pebbles, count);
 
-    // Небольшое сглаживание
-    {
-        std::vector<float> tmp = terrain;
-        int smoothRadius = 2;
-        for (int pass = 0; pass < 1; ++pass) {
-            tmp = terrain;
-            for (int x = smoothRadius; x < width - smoothRadius; ++x) {
-                float sum = 0.0f;
-                for (int k = -smoothRadius; k <= smoothRadius; ++k) sum += tmp[x + k];
-                terrain[x] = sum / (2.0f * smoothRadius + 1.0f);
+            for (int k = 0; k < count; ++k) {
+                float h = baseY - (n[k] * mountainScale);
+                h += pebbles[k] * 1.5f;
+                terrain[b + k] = clampf(h, 100.0f, (float)Config::WINDOW_HEIGHT - 20.0f);
             }
         }
-    }
-
-    int numZones = 1 + std::rand() % 4; 
-    const int zoneWidth = 60; 
-    const int blendW = 30; 
+    });
+}
 
+// До numZones ровных площадок с центрами в [lo, hi); площадки не налезают
+// друг на друга. Склоны по ZONE_BLEND столбцов с каждой стороны
+static void placeZones(std::vector<float>& terrain, std::mt19937& rng, int numZones, int lo, int hi) {
+    const int width = (int)terrain.size();
     std::vector<int> usedCenters;
 
-    for (int i = 0; i < numZones; ++i) {
-        int zoneX = 80 + std::rand() % (width - 160);
+    // на узком рельефе зоны могут не уместиться — попытки ограничены
+    int attempts = (hi > lo) ? 64 * numZones : 0;
+    for (int i = 0; i < numZones && attempts > 0; --attempts) {
+        int zoneX = lo + (int)(rng() % (unsigned)(hi - lo));
         bool ok = true;
         for (int c : usedCenters) {
-            if (std::abs(c - zoneX) < zoneWidth + 2 * blendW) { ok = false; break; }
+            if (std::abs(c - zoneX) < ZONE_WIDTH + 2 * ZONE_BLEND) { ok = false; break; }
         }
-        if (!ok) { --i; continue; }
+        if (!ok) continue;
         usedCenters.push_back(zoneX);
+        ++i;
 
         float zoneHeight = terrain[zoneX];
 
-        int padL = zoneX - zoneWidth / 2;
-        int padR = zoneX + zoneWidth / 2;
+        int padL = zoneX - ZONE_WIDTH / 2;
+        int padR = zoneX + ZONE_WIDTH / 2;
 
         for (int x = padL; x <= padR; ++x) {
             if (x >= 0 && x < width) terrain[x] = zoneHeight;
         }
 
-        for (int x = padL - blendW; x < padL; ++x) {
+        for (int x = padL - ZONE_BLEND; x < padL; ++x) {
             if (x <= 0 || x >= width) continue;
-            float t = (float)(x - (padL - blendW)) / (float)blendW; 
+            float t = (float)(x - (padL - ZONE_BLEND)) / (float)ZONE_BLEND;
             float w = smoothstep01(t);
             terrain[x] = lerp(terrain[x], zoneHeight, w);
         }
 
-        for (int x = padR + 1; x <= padR + blendW; ++x) {
+        for (int x = padR + 1; x <= padR + ZONE_BLEND; ++x) {
             if (x <= 0 || x >= width) continue;
-            float t = (float)(x - (padR + 1)) / (float)blendW; 
+            float t = (float)(x - (padR + 1)) / (float)ZONE_BLEND;
             float w = smoothstep01(t);
             terrain[x] = lerp(zoneHeight, terrain[x], w);
         }
     }
+}
+
+std::vector<float> TerrainGenerator::generate(int width, int seed) {
+    width = std::max(0, width);
+    std::vector<float> terrain(width);
+    std::vector<float> tmp(width);
+    WorkerPool& workers = pool ? *pool : WorkerPool::shared();
+
+    fillNoise(workers, terrain, 0, seed);
+
+    // Небольшое сглаживание
+    smooth(workers, terrain, tmp, cfg.fineRadius, cfg.finePasses);
+
+    // Зоны посадки: своя последовательность от seed, результат не зависит
+    // от того, что ещё в процессе пользуется std::rand
+    std::mt19937 rng((unsigned)seed);
+    int numZones = 1 + (int)(rng() % 4);
+    placeZones(terrain, rng, numZones, 80, width - 80);
 
     // Сильное сглаживание
-    {
-        std::vector<float> tmp = terrain;
-        int smoothRadius = 6;
-        for (int pass = 0; pass < 2; ++pass) {
-            tmp = terrain;
-            for (int x = smoothRadius; x < width - smoothRadius; ++x) {
-                float sum = 0.0f;
-                for (int k = -smoothRadius; k <= smoothRadius; ++k) sum += tmp[x + k];
-                terrain[x] = sum / (2.0f * smoothRadius + 1.0f);
-            }
-        }
-    }
+    smooth(workers, terrain, tmp, cfg.smoothRadius, cfg.smoothPasses);
 
     return terrain;
 }
+
+std::vector<float> TerrainGenerator::generateChunk(int seed, int index, int width) {
+    width = std::max(0, width);
+    WorkerPool& workers = pool ? *pool : WorkerPool::shared();
+
+    // Кусок считается с полями: столбцы у края искажает и сглаживание, и
+    // отсутствие соседей. Поля шириной в охват обоих сглаживаний дают на
+    // самом куске те же значения, что и у рельефа без краёв
+    const int fineReach = smoothReach(cfg.fineRadius, cfg.finePasses);
+    const int coarseReach = smoothReach(cfg.smoothRadius, cfg.smoothPasses);
+    const int halo = fineReach + coarseReach;
+    std::vector<float> terrain((size_t)width + 2 * halo);
+    std::vector<float> tmp(terrain.size());
+
+    fillNoise(workers, terrain, index * width - halo, seed);
+    smooth(workers, terrain, tmp, cfg.fineRadius, cfg.finePasses);
+
+    // Площадки со склонами целиком внутри куска и дальше охвата сильного
+    // сглаживания от его краёв: тогда соседу, досчитывающему свои поля, о
+    // чужих площадках знать не нужно
+    std::seed_seq seq{seed, index};
+    std::mt19937 rng(seq);
+    int numZones = 1 + (int)(rng() % 3);
+    const int margin = coarseReach + ZONE_WIDTH / 2 + ZONE_BLEND + 1;
+    placeZones(terrain, rng, numZones, halo + margin, halo + width - margin);
+
+    smooth(workers, terrain, tmp, cfg.smoothRadius, cfg.smoothPasses);
+
+    return std::vector<float>(terrain.begin() + halo, terrain.begin() + halo + width);
+}
@@ -0,0 +1,160 @@
+#include "Trace.h"
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    enum class Kind : std::uint8_t { Complete, Instant };
+
+    struct Event {
+        const char* name;
+        const char* category;
+        std::int64_t tsNs;      // от начала трассы
+        std::int64_t durNs;
+        Kind kind;
+    };
+
+    struct ThreadRing {
+        int tid = 0;
+        std::atomic<const char*> name{nullptr};
+        std::vector<Event> events;
+        std::atomic<std::uint64_t> head{0};     // всего записано; слот head % RING_EVENTS
+        std::atomic<unsigned> generation{0};    // с какого start() кольцо актуально
+        std::atomic<bool> writing{false};       // владелец сейчас в push
+    };
+
+    std::atomic<std::int64_t> epochNs{0};
+    std::atomic<unsigned> currentGeneration{0};
+
+    // Реестр нужен только при заведении кольца и при сохранении
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<ThreadRing>> registry;
+
+    thread_local ThreadRing* localRing = nullptr;
+    thread_local const char* localName = nullptr;
+
+    std::int64_t nowNs(Trace::Clock::time_point t) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    }
+
+    ThreadRing& ring() {
+        if (!localRing) {
+            auto r = std::make_unique<ThreadRing>();
+            r->events.resize(Trace::RING_EVENTS);
+            std::lock_guard<std::mutex> lock(registryMutex);
+            r->tid = (int)registry.size() + 1;
+            r->name.store(localName, std::memory_order_relaxed);
+            localRing = r.get();
+            registry.push_back(std::move(r));
+        }
+        // кольцо с прошлой трассы: начинаем заново
+        unsigned gen = currentGeneration.load(std::memory_order_relaxed);
+        if (localRing->generation.load(std::memory_order_relaxed) != gen) {
+            localRing->head.store(0, std::memory_order_relaxed);
+            localRing->generation.store(gen, std::memory_order_relaxed);
+        }
+        return *localRing;
+    }
+
+    // Пишем, только пока запись включена. Замер, открытый до stop(), закрывается
+    // уже после него — такое событие отбрасывается. writing и флаг записи
+    // читаются крест-накрест (seq_cst) с stop(): либо push видит выключенную
+    // запись, либо stop() дождётся, пока push допишет
+    void push(const Event& e) {
+        ThreadRing& r = ring();
+        r.writing.store(true, std::memory_order_seq_cst);
+        if (Trace::enabledFlag.load(std::memory_order_seq_cst)) {
+            std::uint64_t h = r.head.load(std::memory_order_relaxed);
+            r.events[h % Trace::RING_EVENTS] = e;
+            r.head.store(h + 1, std::memory_order_release);
+        }
+        r.writing.store(false, std::memory_order_release);
+    }
+
+    // Имена и категории — наши литералы, но кавычки и \ всё равно экранируем
+    void writeString(FILE* f, const char* s) {
+        std::fputc('"', f);
+        for (; *s; ++s) {
+            if (*s == '"' || *s == '\\') std::fputc('\\', f);
+            std::fputc(*s, f);
+        }
+        std::fputc('"', f);
+    }
+}
+
+std::atomic<bool> Trace::enabledFlag{false};
+
+void Trace::start() {
+    epochNs.store(nowNs(Clock::now()), std::memory_order_relaxed);
+    currentGeneration.fetch_add(1, std::memory_order_relaxed);
+    enabledFlag.store(true, std::memory_order_release);
+}
+
+void Trace::stop() {
+    enabledFlag.store(false, std::memory_order_seq_cst);
+    // дождаться событий, которые уже пишутся: после этого кольца не меняются
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const auto& r : registry) {
+        while (r->writing.load(std::memory_order_acquire)) std::this_thread::yield();
+    }
+}
+
+void Trace::setThreadName(const char* name) {
+    // кольцо (и память под него) появится только с первым событием
+    localName = name;
+    if (localRing) localRing->name.store(name, std::memory_order_relaxed);
+}
+
+void Trace::complete(const char* name, const char* category, Clock::time_point begin, std::int64_t durNs) {
+    push({name, category, nowNs(begin) - epochNs.load(std::memory_order_relaxed), durNs, Kind::Complete});
+}
+
+void Trace::instant(const char* name, const char* category) {
+    push({name, category, nowNs(Clock::now()) - epochNs.load(std::memory_order_relaxed), 0, Kind::Instant});
+}
+
+bool Trace::writeJson(const std::string& path) {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+
+    std::fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    auto sep = [&]() { std::fputs(first ? "" : ",\n", f); first = false; };
+
+    unsigned gen = currentGeneration.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const auto& rp : registry) {
+        const ThreadRing& r = *rp;
+        if (r.generation.load(std::memory_order_relaxed) != gen) continue;
+
+        if (const char* name = r.name.load(std::memory_order_relaxed)) {
+            sep();
+            std::fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", r.tid);
+            writeString(f, name);
+            std::fputs("}}", f);
+        }
+
+        // Кольцо переполнено — самый старый слот следующим и затрётся: его не берём
+        std::uint64_t head = r.head.load(std::memory_order_acquire);
+        std::uint64_t begin = head > (std::uint64_t)RING_EVENTS ? head - RING_EVENTS + 1 : 0;
+        for (std::uint64_t i = begin; i < head; ++i) {
+            const Event& e = r.events[i % RING_EVENTS];
+            sep();
+            std::fputs("{\"name\":", f);
+            writeString(f, e.name);
+            std::fputs(",\"cat\":", f);
+            writeString(f, e.category);
+            if (e.kind == Kind::Complete) {
+                std::fprintf(f, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                             e.tsNs * 1e-3, e.durNs * 1e-3, r.tid);
+            } else {
+                std::fprintf(f, ",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}",
+                             e.tsNs * 1e-3, r.tid);
+            }
+        }
+    }
+    std::fprintf(f, "\n]}\n");
+    return std::fclose(f) == 0;
+}
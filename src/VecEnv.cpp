@@ -0,0 +1,140 @@
+#include "VecEnv.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <random>
+
+static float totalFuel(const RoverState& s) {
+    float f = s.fuelMain;
+    for (float t : s.auxTanks) f += t;
+    return f;
+}
+
+// Seed эпизода episode > 0 среды, начатой с base: перемешивание splitmix64
+static int episodeSeed(int base, int episode) {
+    std::uint64_t z = ((std::uint64_t)(std::uint32_t)base << 32) | (std::uint32_t)episode;
+    z += 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    z ^= z >> 31;
+    return (int)(std::uint32_t)z;
+}
+
+VecEnv::VecEnv(int numEnvs, const VecEnvConfig& config)
+    : cfg(config), envs((size_t)std::max(0, numEnvs))
+{
+    cfg.radarSamples = std::max(0, cfg.radarSamples);
+    cfg.windMax = std::clamp(cfg.windMax, 0.0f, Config::WIND_MAX);
+}
+
+void VecEnv::resetEnv(Env& e, int seed) {
+    // старт и ветер миссии выводятся из её seed
+    std::mt19937 rng((unsigned)seed);
+    std::uniform_real_distribution<float> startDist(cfg.startXMin, cfg.startXMax);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    float startX = startDist(rng);
+    Vec2 wind{unit(rng) * cfg.windMax, unit(rng) * cfg.windMax};
+
+    e.sim.reset(seed, startX);
+    e.sim.setWind(wind);
+    e.seed = seed;
+    e.fuelStart = totalFuel(e.sim.getState());
+    e.fuel = e.fuelStart;
+    e.reward = 0.0f;
+    e.done = EnvDone::Running;
+}
+
+void VecEnv::stepEnv(Env& e, const float* action) {
+    ControlOutput ctrl{action[0], action[1], action[2], action[3], action[4]};
+    e.sim.step(ctrl);
+
+    const RoverState& s = e.sim.getState();
+    float fuel = totalFuel(s);
+    e.reward = -cfg.fuelCost * (e.fuel - fuel);
+    e.fuel = fuel;
+
+    if (s.landed) {
+        e.reward += cfg.landReward;
+        e.done = EnvDone::Landed;
+    } else if (s.crashed) {
+        e.reward += cfg.crashReward;
+        e.done = EnvDone::Crashed;
+    } else if (e.sim.stepCount() >= cfg.maxSteps) {
+        e.done = EnvDone::Timeout;
+    } else {
+        e.done = EnvDone::Running;
+    }
+}
+
+void VecEnv::writeObs(const Env& e, float* out) const {
+    const Simulation& sim = e.sim;
+    const RoverState& s = sim.getState();
+    out[0] = sim.groundAt(s.x) - s.y;
+    out[1] = s.vx;
+    out[2] = s.vy;
+    out[3] = s.angle;
+    out[4] = s.angularVel;
+    out[5] = (e.fuelStart > 0.0f) ? e.fuel / e.fuelStart : 0.0f;
+
+    if (sim.hasLandingTarget()) {
+        const LandingSite& site = sim.getLandingTarget();
+        out[6] = 1.0f;
+        out[7] = site.centerX - s.x;
+        out[8] = site.yMean - s.y;
+    } else {
+        out[6] = out[7] = out[8] = 0.0f;
+    }
+
+    Vec2 wind = sim.getWind();
+    out[9] = wind.x;
+    out[10] = wind.y;
+
+    // лучи радара: равномерная выборка из скана этого шага
+    const RadarHitBuffer& hits = sim.getRadarHits();
+    float* radar = out + STATE_OBS;
+    const int n = hits.size();
+    const float range = sim.radarCfg.maxRange;
+    for (int k = 0; k < cfg.radarSamples; ++k) {
+        if (n == 0) { radar[k] = 1.0f; continue; }
+        int r = (cfg.radarSamples > 1) ? (int)((long long)k * (n - 1) / (cfg.radarSamples - 1)) : n / 2;
+        radar[k] = hits.hit[r] ? std::min(1.0f, hits.t[r] / range) : 1.0f;
+    }
+}
+
+void VecEnv::reset(const int* seeds, float* obs) {
+    const int n = size();
+    const int stride = obsSize();
+
+    // первое наблюдение: скан с места старта, шаг при этом не делается
+    WorkerPool::shared().parallelFor(n, 8, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            Env& e = envs[i];
+            e.baseSeed = seeds[i];
+            e.episode = 0;
+            resetEnv(e, seeds[i]);
+            e.sim.scanRadarAt(e.sim.getState().angle);
+            writeObs(e, obs + (size_t)i * stride);
+        }
+    });
+}
+
+void VecEnv::step(const float* actions, float* obs, float* rewards, EnvDone* dones) {
+    const int n = size();
+    const int stride = obsSize();
+
+    WorkerPool::shared().parallelFor(n, 8, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            Env& e = envs[i];
+            stepEnv(e, actions + (size_t)i * ACTION_SIZE);
+            rewards[i] = e.reward;
+            dones[i] = e.done;
+
+            // автосброс: в obs уходит первое наблюдение новой миссии
+            if (e.done != EnvDone::Running) {
+                ++e.episode;
+                resetEnv(e, episodeSeed(e.baseSeed, e.episode));
+                e.sim.scanRadarAt(e.sim.getState().angle);
+            }
+            writeObs(e, obs + (size_t)i * stride);
+        }
+    });
+}
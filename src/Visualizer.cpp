@@ -1,11 +1,15 @@
 #include "Visualizer.h"
+#include "Profiler.h"
 #include <cstdlib>
 #include <algorithm>
 #include <string> 
 #include <cstdio>
 #include <cmath>
 
-Visualizer::Visualizer() {
+Visualizer::Visualizer()
+    : foundMsg(font, 16, sf::Color(0, 255, 0, 230)),
+      pausedText(font, "PAUSED", 48)
+{
     std::vector<std::string> fontPaths;
     #ifdef _WIN32
         fontPaths.push_back("C:/Windows/Fonts/arial.ttf");
@@ -27,6 +31,30 @@ Visualizer::Visualizer() {
         }
     }
 
+    hud.reserve(HUD_LINE_COUNT);
+    for (int i = 0; i < HUD_LINE_COUNT; ++i) hud.emplace_back(font, 14, sf::Color::White);
+    if (fontLoaded) hudLineHeight = font.getLineSpacing(14);
+
+    profLines.reserve(PROFILE_STAGE_COUNT + 2);
+    for (int i = 0; i < PROFILE_STAGE_COUNT + 2; ++i) profLines.emplace_back(font, 13, sf::Color(255, 255, 160));
+    profPanel.setFillColor(sf::Color(0, 0, 0, 170));
+    profPanel.setOutlineColor(sf::Color(255, 255, 160, 160));
+    profPanel.setOutlineThickness(1.f);
+
+    hudPanel.setPosition({10.f, 10.f});
+    hudPanel.setFillColor(sf::Color(0, 0, 0, 150));
+    hudPanel.setOutlineColor(sf::Color::White);
+    hudPanel.setOutlineThickness(1.f);
+
+    foundMsg.text.setPosition({20.f, 220.f});
+
+    pausedText.setFillColor(sf::Color(255, 255, 255, 230));
+    auto bounds = pausedText.getLocalBounds();
+    pausedText.setOrigin({bounds.position.x + bounds.size.x * 0.5f,
+                          bounds.position.y + bounds.size.y * 0.5f});
+    pausedText.setPosition({Config::WINDOW_WIDTH * 0.5f,
+                            Config::WINDOW_HEIGHT * 0.5f});
+
     for (int i = 0; i < 100; i++) {
         stars.push_back({(float)(std::rand() % Config::WINDOW_WIDTH), (float)(std::rand() % Config::WINDOW_HEIGHT)});
     }
@@ -38,71 +66,121 @@ Visualizer::Visualizer() {
             (float)(std::rand() % Config::WINDOW_HEIGHT)
         });
     }
+
+    // Небо
+    sky.vertices = {
+        sf::Vertex{ sf::Vector2f(0.f, 0.f), Config::MARS_SKY_TOP },
+        sf::Vertex{ sf::Vector2f((float)Config::WINDOW_WIDTH, 0.f), Config::MARS_SKY_TOP },
+        sf::Vertex{ sf::Vector2f(0.f, (float)Config::WINDOW_HEIGHT), Config::MARS_SKY_BOTTOM },
+        sf::Vertex{ sf::Vector2f((float)Config::WINDOW_WIDTH, (float)Config::WINDOW_HEIGHT), Config::MARS_SKY_BOTTOM }
+    };
+    sky.upload();
+
+    starPoints.vertices.resize(stars.size());
+    for (size_t i = 0; i < stars.size(); i++) {
+        starPoints.vertices[i].position = stars[i];
+        starPoints.vertices[i].color = sf::Color(255, 255, 255, 150);
+    }
+    starPoints.upload();
+}
+
+bool Visualizer::HudField::set(const char* value) {
+    if (shown == value) return false;
+    shown = value;
+    text.setString(value);
+    return true;
+}
+
+void Visualizer::StaticMesh::upload() {
+    onGpu = !vertices.empty() && sf::VertexBuffer::isAvailable() &&
+            buffer.create(vertices.size()) && buffer.update(vertices.data());
+}
+
+void Visualizer::StaticMesh::draw(sf::RenderTarget& target) const {
+    if (vertices.empty()) return;
+    if (onGpu) target.draw(buffer);
+    else target.draw(vertices.data(), vertices.size(), type);
+}
+
+void Visualizer::setTerrain(const std::vector<float>& terrain, int originX) {
+    ground.vertices.resize(terrain.size() * 2);
+    for (size_t i = 0; i < terrain.size(); i++) {
+        float h = terrain[i];
+        float x = (float)(originX + (int)i);
+        ground.vertices[i * 2].position = sf::Vector2f(x, h);
+        ground.vertices[i * 2].color = Config::TERRAIN_COLOR_TOP;
+        ground.vertices[i * 2 + 1].position = sf::Vector2f(x, (float)Config::WINDOW_HEIGHT);
+        ground.vertices[i * 2 + 1].color = Config::TERRAIN_COLOR_BOTTOM;
+    }
+    ground.upload();
 }
 
 void Visualizer::draw(sf::RenderWindow& window, const RoverState& state, 
-                      const std::vector<float>& terrain, 
-                      const std::vector<RayHit>& radarHits,
+                      const RadarHitBuffer& radarHits,
                       bool hasTargetSite,
                       const LandingSite& targetSite,
                       bool autoMode, bool paused,
                       float foundMsgTimer,
                       sf::Vector2f wind,
                       float timeScale,
+                      bool turbo,
+                      float stepsPerSecond,
                       int gimbalMode,
                       const char* phaseName) 
 {
-    // Небо
-    sf::VertexArray sky(sf::PrimitiveType::TriangleStrip, 4);
-    sky[0] = sf::Vertex{ sf::Vector2f(0.f, 0.f), Config::MARS_SKY_TOP };
-    sky[1] = sf::Vertex{ sf::Vector2f((float)Config::WINDOW_WIDTH, 0.f), Config::MARS_SKY_TOP };
-    sky[2] = sf::Vertex{ sf::Vector2f(0.f, (float)Config::WINDOW_HEIGHT), Config::MARS_SKY_BOTTOM };
-    sky[3] = sf::Vertex{ sf::Vector2f((float)Config::WINDOW_WIDTH, (float)Config::WINDOW_HEIGHT), Config::MARS_SKY_BOTTOM };
-    window.draw(sky);
-
-    sf::VertexArray starPoints(sf::PrimitiveType::Points, stars.size());
-    for (size_t i = 0; i < stars.size(); i++) {
-        starPoints[i].position = stars[i];
-        starPoints[i].color = sf::Color(255, 255, 255, 150);
-    }
-    window.draw(starPoints);
-
-    // Ландшафт
-    if (!terrain.empty()) {
-        sf::VertexArray ground(sf::PrimitiveType::TriangleStrip, terrain.size() * 2);
-        for (size_t i = 0; i < terrain.size(); i++) {
-            float h = terrain[i];
-            ground[i * 2].position = sf::Vector2f((float)i, h);
-            ground[i * 2].color = Config::TERRAIN_COLOR_TOP;
-            ground[i * 2 + 1].position = sf::Vector2f((float)i, (float)Config::WINDOW_HEIGHT);
-            ground[i * 2 + 1].color = Config::TERRAIN_COLOR_BOTTOM;
-        }
-        window.draw(ground);
+    hudRelayouts = 0;
+    ProfileScope probe(ProfileStage::DrawBackground);
+
+    // Небо, звёзды и ландшафт — готовые буферы. Небо со звёздами за камерой не
+    // едут, всё остальное рисуется в виде, сдвинутом на cameraX
+    const sf::View currentView = window.getView();
+    sky.draw(window);
+    starPoints.draw(window);
+    if (cameraX != 0.0f) {
+        sf::View worldView = currentView;
+        worldView.move({cameraX, 0.0f});
+        window.setView(worldView);
     }
+    ground.draw(window);
 
-    // Лучи радара
-    for (const auto& h : radarHits) {
-        sf::Vector2f o{h.origin.x, h.origin.y};
-        sf::Vector2f e = h.hit ? sf::Vector2f(h.point.x, h.point.y)
-                               : sf::Vector2f(h.origin.x + h.dir.x * h.t, h.origin.y + h.dir.y * h.t);
-
-        sf::VertexArray ray(sf::PrimitiveType::Lines, 2);
-        ray[0].position = o;
-        ray[1].position = e;
-        ray[0].color = sf::Color(0, 255, 255, 110);
-        ray[1].color = sf::Color(0, 255, 255, 40);
-        window.draw(ray);
-
-        if (h.hit) {
-            sf::CircleShape p(2.0f);
-            p.setOrigin({2.0f, 2.0f});
-            p.setPosition(e);
-            p.setFillColor(sf::Color(0, 255, 0, 180));
-            window.draw(p);
+    // Лучи радара (для промаха точка в буфере уже стоит на конце луча)
+    probe.restart(ProfileStage::DrawRadar);
+    {
+        const int n = radarHits.size();
+        const sf::Vector2f o{radarHits.origin.x, radarHits.origin.y};
+        const sf::Color rayNear(0, 255, 255, 110);
+        const sf::Color rayFar(0, 255, 255, 40);
+        const sf::Color mark(0, 255, 0, 180);
+        const float r = 2.0f;   // полуразмер квадрата отметки
+
+        radarRays.resize((size_t)n * 2);
+        size_t marks = 0;
+        for (int i = 0; i < n; ++i) marks += radarHits.hit[i] ? 1 : 0;
+        radarMarks.resize(marks * 6);
+
+        size_t m = 0;
+        for (int i = 0; i < n; ++i) {
+            sf::Vector2f e{radarHits.px[i], radarHits.py[i]};
+            radarRays[i * 2]     = sf::Vertex{o, rayNear};
+            radarRays[i * 2 + 1] = sf::Vertex{e, rayFar};
+
+            if (radarHits.hit[i]) {
+                sf::Vector2f a{e.x - r, e.y - r}, b{e.x + r, e.y - r};
+                sf::Vector2f c{e.x + r, e.y + r}, d{e.x - r, e.y + r};
+                radarMarks[m++] = sf::Vertex{a, mark};
+                radarMarks[m++] = sf::Vertex{b, mark};
+                radarMarks[m++] = sf::Vertex{c, mark};
+                radarMarks[m++] = sf::Vertex{a, mark};
+                radarMarks[m++] = sf::Vertex{c, mark};
+                radarMarks[m++] = sf::Vertex{d, mark};
+            }
         }
+        window.draw(radarRays);
+        window.draw(radarMarks);
     }
 
     // Лучшая площадка
+    probe.restart(ProfileStage::DrawLander);
     if (hasTargetSite) {
         float w = std::max(1.0f, targetSite.x1 - targetSite.x0);
         sf::RectangleShape s({w, 6.f});
@@ -214,7 +292,7 @@ void Visualizer::draw(sf::RenderWindow& window, const RoverState& state,
     drawSideJet({-12.f, 0.f}, state.leftThrust,  state.leftGimbal,  true);
     drawSideJet({+12.f, 0.f}, state.rightThrust, state.rightGimbal, false);
 
-    sf::View currentView = window.getView();
+    probe.restart(ProfileStage::DrawHud);
     sf::View screenView = window.getDefaultView();
     window.setView(screenView);
 
@@ -250,18 +328,15 @@ void Visualizer::draw(sf::RenderWindow& window, const RoverState& state,
         }
     }
 
-    drawHUD(window, state, autoMode, paused, wind, timeScale, gimbalMode, phaseName,
+    drawHUD(window, state, autoMode, paused, wind, timeScale, turbo, stepsPerSecond, gimbalMode, phaseName,
             hasTargetSite, targetSite);
 
     if (foundMsgTimer > 0.0f && hasTargetSite) {
-        sf::Text msg(font);
-        msg.setCharacterSize(16);
-        msg.setFillColor(sf::Color(0, 255, 0, 230));
-        msg.setString("Landing site found: x=" +
-                      std::to_string((int)targetSite.centerX) +
-                      " y=" + std::to_string((int)targetSite.yMean));
-        msg.setPosition({20.f, 220.f});
-        window.draw(msg);
+        char msg[64];
+        std::snprintf(msg, sizeof(msg), "Landing site found: x=%d y=%d",
+                      (int)targetSite.centerX, (int)targetSite.yMean);
+        if (foundMsg.set(msg)) ++hudRelayouts;
+        window.draw(foundMsg.text);
     }
 
     window.setView(currentView);
@@ -273,6 +348,8 @@ void Visualizer::drawHUD(sf::RenderWindow& window,
                          bool paused,
                          sf::Vector2f wind,
                          float timeScale,
+                         bool turbo,
+                         float stepsPerSecond,
                          int gimbalMode,
                          const char* phaseName,
                          bool hasTargetSite,
@@ -281,63 +358,63 @@ void Visualizer::drawHUD(sf::RenderWindow& window,
     float panelHeight = 260.f;
     if (hasTargetSite) panelHeight += 50.f;
 
-    sf::RectangleShape panel({270.f, panelHeight}); 
-    panel.setPosition({10.f, 10.f});
-    panel.setFillColor(sf::Color(0, 0, 0, 150));
-    panel.setOutlineColor(sf::Color::White);
-    panel.setOutlineThickness(1.f);
-    window.draw(panel);
+    hudPanel.setSize({270.f, panelHeight});
+    window.draw(hudPanel);
 
-    std::string status = "FLYING";
+    const char* status = "FLYING";
     if (state.crashed) status = "CRASHED";
     else if (state.landed) status = "LANDED SUCCESS";
 
-    char timeScaleStr[16];
-    std::snprintf(timeScaleStr, sizeof(timeScaleStr), "%.2fx", timeScale);
-
-    float angleDeg = state.angle * 180.0f / 3.14159265f;
-    char angleStr[16];
-    std::snprintf(angleStr, sizeof(angleStr), "%.1f", angleDeg);
-
-    std::string gimbalModeStr;
+    const char* gimbalModeStr = "BOTH";
     if (gimbalMode == 1) gimbalModeStr = "LEFT";
     else if (gimbalMode == 2) gimbalModeStr = "RIGHT";
-    else gimbalModeStr = "BOTH";
 
-    std::string targetInfo;
-    if (hasTargetSite) {
-        float distX = targetSite.centerX - state.x;
-        float altToTarget = targetSite.yMean - state.y;
-        targetInfo =
-            "\n--- Landing Site ---"
-            "\nTarget: (" + std::to_string((int)targetSite.centerX) + ", " + std::to_string((int)targetSite.yMean) + ")"
-            "\nDist X: " + std::to_string((int)distX) + " px"
-            "\nAlt: " + std::to_string((int)altToTarget);
-    }
+    // Строки идут подряд, скрытые не занимают места
+    char buf[96];
+    int row = 0;
+    auto showLine = [&](HudLine id) {
+        HudField& f = hud[id];
+        if (f.set(buf)) ++hudRelayouts;
+        f.text.setPosition({20.f, 20.f + row * hudLineHeight});
+        window.draw(f.text);
+        ++row;
+    };
 
+    std::snprintf(buf, sizeof(buf), "Status: %s", status);
+    showLine(HudStatus);
+    std::snprintf(buf, sizeof(buf), "Phase: %s", phaseName ? phaseName : "?");
+    showLine(HudPhase);
+    std::snprintf(buf, sizeof(buf), "Mode: %s", autoMode ? "AUTOPILOT" : "MANUAL");
+    showLine(HudMode);
+    std::snprintf(buf, sizeof(buf), "Angle: %.1f deg", state.angle * 180.0f / 3.14159265f);
+    showLine(HudAngle);
+    std::snprintf(buf, sizeof(buf), "X: %d  Y: %d", (int)state.x, (int)state.y);
+    showLine(HudPos);
+    std::snprintf(buf, sizeof(buf), "Vx: %d  Vy: %d", (int)state.vx, (int)state.vy);
+    showLine(HudVel);
+    std::snprintf(buf, sizeof(buf), "Fuel: %d", (int)state.fuelMain);
+    showLine(HudFuel);
+    if (turbo) std::snprintf(buf, sizeof(buf), "Time: TURBO  %.0f steps/s", stepsPerSecond);
+    else std::snprintf(buf, sizeof(buf), "Time: %.2fx  %.0f steps/s", timeScale, stepsPerSecond);
+    showLine(HudTime);
     float windMag = std::sqrt(wind.x * wind.x + wind.y * wind.y);
-    char windStr[64];
-    std::snprintf(windStr, sizeof(windStr), "(%.0f, %.0f) |W|=%.0f", wind.x, wind.y, windMag);
-
-    std::string info = 
-        "Status: " + status + "\n" +
-        "Phase: " + std::string(phaseName ? phaseName : "?") + "\n" +
-        "Mode: " + (autoMode ? "AUTOPILOT" : "MANUAL") + "\n" +
-        "Angle: " + std::string(angleStr) + " deg\n" +
-        "X: " + std::to_string((int)state.x) + "  Y: " + std::to_string((int)state.y) + "\n" +
-        "Vx: " + std::to_string((int)state.vx) + "  Vy: " + std::to_string((int)state.vy) + "\n" +
-        "Fuel: " + std::to_string((int)state.fuelMain) + "\n" +
-        "Time: " + std::string(timeScaleStr) + "\n" +
-        "Wind: " + std::string(windStr) +
-        (autoMode ? "" : "\nGimbal: " + gimbalModeStr) +
-        targetInfo;
-
-    sf::Text txt(font);
-    txt.setCharacterSize(14);
-    txt.setFillColor(sf::Color::White);
-    txt.setPosition({20.f, 20.f});
-    txt.setString(info);
-    window.draw(txt);
+    std::snprintf(buf, sizeof(buf), "Wind: (%.0f, %.0f) |W|=%.0f", wind.x, wind.y, windMag);
+    showLine(HudWind);
+    if (!autoMode) {
+        std::snprintf(buf, sizeof(buf), "Gimbal: %s", gimbalModeStr);
+        showLine(HudGimbal);
+    }
+
+    if (hasTargetSite) {
+        std::snprintf(buf, sizeof(buf), "--- Landing Site ---");
+        showLine(HudSiteHeader);
+        std::snprintf(buf, sizeof(buf), "Target: (%d, %d)", (int)targetSite.centerX, (int)targetSite.yMean);
+        showLine(HudSite);
+        std::snprintf(buf, sizeof(buf), "Dist X: %d px", (int)(targetSite.centerX - state.x));
+        showLine(HudSiteDist);
+        std::snprintf(buf, sizeof(buf), "Alt: %d", (int)(targetSite.yMean - state.y));
+        showLine(HudSiteAlt);
+    }
 
     // Индикатор ветра: круг + вектор
     {
@@ -372,16 +449,41 @@ void Visualizer::drawHUD(sf::RenderWindow& window,
         
     }
 
-    if (paused) {
-        sf::Text pausedTxt(font);
-        pausedTxt.setString("PAUSED");
-        pausedTxt.setCharacterSize(48);
-        pausedTxt.setFillColor(sf::Color(255, 255, 255, 230));
-        auto bounds = pausedTxt.getLocalBounds();
-        pausedTxt.setOrigin({bounds.position.x + bounds.size.x * 0.5f,
-                             bounds.position.y + bounds.size.y * 0.5f});
-        pausedTxt.setPosition({Config::WINDOW_WIDTH * 0.5f,
-                               Config::WINDOW_HEIGHT * 0.5f});
-        window.draw(pausedTxt);
+    if (paused) window.draw(pausedText);
+}
+
+void Visualizer::drawProfiler(sf::RenderWindow& window, const ProfileReport& report) {
+    sf::View currentView = window.getView();
+    window.setView(window.getDefaultView());
+
+    const float x = (float)Config::WINDOW_WIDTH - 350.f;
+    const float y = 140.f;
+    const float lh = hudLineHeight;
+    const int lines = PROFILE_STAGE_COUNT + 2;
+
+    profPanel.setPosition({x - 10.f, y - 8.f});
+    profPanel.setSize({340.f, lines * lh + 16.f});
+    window.draw(profPanel);
+
+    char buf[96];
+    auto showLine = [&](int row) {
+        HudField& f = profLines[row];
+        f.set(buf);
+        f.text.setPosition({x, y + row * lh});
+        window.draw(f.text);
+    };
+
+    std::snprintf(buf, sizeof(buf), "stage            mean     p99     max  us");
+    showLine(0);
+    for (int s = 0; s < PROFILE_STAGE_COUNT; ++s) {
+        const ProfileStageStats& st = report.stages[s];
+        ProfileStage stage = (ProfileStage)s;
+        std::snprintf(buf, sizeof(buf), "%s%-16s %7.1f %7.1f %7.1f", Profiler::stageNested(stage) ? "  " : "",
+                      Profiler::stageName(stage), st.meanUs, st.p99Us, st.maxUs);
+        showLine(1 + s);
     }
+    std::snprintf(buf, sizeof(buf), "hud relayouts/frame: %d", hudRelayouts);
+    showLine(lines - 1);
+
+    window.setView(currentView);
 }
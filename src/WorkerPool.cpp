@@ -0,0 +1,113 @@
+#include "WorkerPool.h"
+#include "Trace.h"
+#include <algorithm>
+
+static thread_local bool insidePool = false;
+
+// insidePool на время задачи; сбрасывается и при исключении
+struct InsidePoolScope {
+    InsidePoolScope() { insidePool = true; }
+    ~InsidePoolScope() { insidePool = false; }
+};
+
+WorkerPool::WorkerPool(int threads) {
+    if (threads <= 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i < threads; ++i) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& t : workers) t.join();
+}
+
+WorkerPool& WorkerPool::shared() {
+    static WorkerPool pool;
+    return pool;
+}
+
+void WorkerPool::runChunks(const ChunkFn& fn, int n, int chunkSize) {
+    try {
+        for (;;) {
+            int begin = nextIndex.fetch_add(chunkSize, std::memory_order_relaxed);
+            if (begin >= n) break;
+            fn(begin, std::min(n, begin + chunkSize));
+        }
+    } catch (...) {
+        // оставшиеся куски уже не нужны: задача всё равно завершится ошибкой
+        nextIndex.store(n, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(m);
+        if (!error) error = std::current_exception();
+    }
+}
+
+void WorkerPool::workerLoop() {
+    insidePool = true;
+    Trace::setThreadName("worker");
+    unsigned seen = 0;
+    for (;;) {
+        const ChunkFn* fn;
+        int n, chunkSize;
+        {
+            std::unique_lock<std::mutex> lock(m);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            fn = job;
+            n = jobSize;
+            chunkSize = chunk;
+        }
+
+        runChunks(*fn, n, chunkSize);
+
+        std::lock_guard<std::mutex> lock(m);
+        if (--busy == 0) finished.notify_one();
+    }
+}
+
+void WorkerPool::run(int n, int minChunk, ChunkFn fn) {
+    if (n <= 0) return;
+    minChunk = std::max(1, minChunk);
+
+    if (workers.empty() || insidePool || n <= minChunk) {
+        fn(0, n);
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit(submitMutex);
+
+    // по несколько кусков на исполнителя, чтобы выровнять неравные по цене лучи/миссии
+    int chunkSize = std::max(minChunk, n / (size() * 4));
+    {
+        std::lock_guard<std::mutex> lock(m);
+        job = &fn;
+        jobSize = n;
+        chunk = chunkSize;
+        error = nullptr;
+        nextIndex.store(0, std::memory_order_relaxed);
+        busy = (int)workers.size();
+        ++generation;
+    }
+    wake.notify_all();
+
+    {
+        InsidePoolScope inside;
+        runChunks(fn, n, chunkSize);
+    }
+
+    // fn живёт на стеке вызывающего: до выхода все исполнители должны закончить
+    std::exception_ptr failed;
+    {
+        std::unique_lock<std::mutex> lock(m);
+        finished.wait(lock, [&] { return busy == 0; });
+        job = nullptr;
+        failed = error;
+        error = nullptr;
+    }
+    if (failed) std::rethrow_exception(failed);
+}
@@ -0,0 +1,266 @@
+// Пакетный прогон миссий без окна: N миссий по пулу потоков, сводка по посадкам,
+// топливу и скоростям касания.
+//
+//   lander_batch --missions 20000 --seed 1 --wind gust --wind-max 20 --csv runs.csv
+#include "Config.h"
+#include "Simulation.h"
+#include "Trace.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+enum class WindProfile { None, Constant, Gust };
+
+struct BatchConfig {
+    int missions = 1000;
+    int seed = 1;
+    int threads = 0;               // 0 — по числу ядер
+    int maxSteps = 180 * 30;       // 3 минуты симуляции
+    float startXMin = 100.0f;
+    float startXMax = (float)Config::WINDOW_WIDTH - 100.0f;
+    WindProfile wind = WindProfile::None;
+    float windMax = 15.0f;
+    bool unbounded = false;        // рельеф кусками без краёв (ChunkedTerrain)
+    std::string csvPath;
+    std::string tracePath;
+};
+
+enum class Outcome { Landed, Crashed, Timeout };
+
+struct MissionResult {
+    int seed = 0;
+    float startX = 0.0f;
+    Outcome outcome = Outcome::Timeout;
+    int steps = 0;
+    float fuelUsed = 0.0f;
+    float touchdownVx = 0.0f;
+    float touchdownVy = 0.0f;
+};
+
+static float totalFuel(const RoverState& s) {
+    float f = s.fuelMain;
+    for (float t : s.auxTanks) f += t;
+    return f;
+}
+
+static void printUsage() {
+    std::printf(
+        "usage: lander_batch [options]\n"
+        "  --missions N        number of missions (1000)\n"
+        "  --seed S            first terrain seed, mission i uses S + i (1)\n"
+        "  --threads T         worker threads, 0 = all cores (0)\n"
+        "  --max-steps M       step limit per mission at 30 Hz (5400)\n"
+        "  --start-x A B       uniform start X range (100 %d)\n"
+        "  --wind none|constant|gust\n"
+        "  --wind-max W        wind magnitude limit (15)\n"
+        "  --unbounded         chunked terrain without edges; any start X\n"
+        "  --csv PATH          per-mission results\n"
+        "  --trace PATH        Chrome trace JSON of the last events per thread\n",
+        Config::WINDOW_WIDTH - 100);
+}
+
+static bool parseArgs(int argc, char** argv, BatchConfig& cfg) {
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        auto next = [&]() -> const char* { return (i + 1 < argc) ? argv[++i] : nullptr; };
+        const char* v = nullptr;
+
+        if (!std::strcmp(a, "--missions") && (v = next())) cfg.missions = std::atoi(v);
+        else if (!std::strcmp(a, "--seed") && (v = next())) cfg.seed = std::atoi(v);
+        else if (!std::strcmp(a, "--threads") && (v = next())) cfg.threads = std::atoi(v);
+        else if (!std::strcmp(a, "--max-steps") && (v = next())) cfg.maxSteps = std::atoi(v);
+        else if (!std::strcmp(a, "--wind-max") && (v = next())) cfg.windMax = (float)std::atof(v);
+        else if (!std::strcmp(a, "--csv") && (v = next())) cfg.csvPath = v;
+        else if (!std::strcmp(a, "--trace") && (v = next())) cfg.tracePath = v;
+        else if (!std::strcmp(a, "--unbounded")) cfg.unbounded = true;
+        else if (!std::strcmp(a, "--start-x") && i + 2 < argc) {
+            cfg.startXMin = (float)std::atof(argv[++i]);
+            cfg.startXMax = (float)std::atof(argv[++i]);
+        }
+        else if (!std::strcmp(a, "--wind") && (v = next())) {
+            if (!std::strcmp(v, "none")) cfg.wind = WindProfile::None;
+            else if (!std::strcmp(v, "constant")) cfg.wind = WindProfile::Constant;
+            else if (!std::strcmp(v, "gust")) cfg.wind = WindProfile::Gust;
+            else return false;
+        }
+        else return false;
+    }
+    cfg.windMax = std::min(cfg.windMax, Config::WIND_MAX);
+    return cfg.missions > 0 && cfg.maxSteps > 0 && cfg.startXMin <= cfg.startXMax;
+}
+
+static MissionResult runMission(const BatchConfig& cfg, int index, Simulation& sim) {
+    MissionResult r;
+    r.seed = cfg.seed + index;
+
+    // всё случайное в миссии выводится из её seed
+    std::mt19937 rng((unsigned)r.seed);
+    std::uniform_real_distribution<float> startDist(cfg.startXMin, cfg.startXMax);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    r.startX = startDist(rng);
+
+    Vec2 base{unit(rng) * cfg.windMax, unit(rng) * cfg.windMax};
+    float gustAmp = 0.5f * cfg.windMax * (0.5f + 0.5f * unit(rng));
+    float gustPeriod = 4.0f + 3.0f * (1.0f + unit(rng));
+    float gustPhase = 3.14159265f * unit(rng);
+
+    sim.reset(r.seed, r.startX);
+    float fuel0 = totalFuel(sim.getState());
+
+    for (int i = 0; i < cfg.maxSteps && !sim.finished(); ++i) {
+        Vec2 w{0.0f, 0.0f};
+        if (cfg.wind == WindProfile::Constant) {
+            w = base;
+        } else if (cfg.wind == WindProfile::Gust) {
+            float t = (float)i * Config::DT;
+            float g = gustAmp * std::sin(2.0f * 3.14159265f * t / gustPeriod + gustPhase);
+            w = {base.x + g, base.y + 0.3f * g};
+        }
+
+        // тот же предел модуля ветра, что и в окне
+        float L = std::sqrt(w.x * w.x + w.y * w.y);
+        if (L > Config::WIND_MAX && L > 1e-6f) {
+            w.x = w.x / L * Config::WIND_MAX;
+            w.y = w.y / L * Config::WIND_MAX;
+        }
+        sim.setWind(w);
+        sim.step();
+    }
+
+    const RoverState& s = sim.getState();
+    r.outcome = s.landed ? Outcome::Landed : (s.crashed ? Outcome::Crashed : Outcome::Timeout);
+    r.steps = sim.stepCount();
+    r.fuelUsed = fuel0 - totalFuel(s);
+    r.touchdownVx = s.touchdownVx;
+    r.touchdownVy = s.touchdownVy;
+    return r;
+}
+
+static float percentile(std::vector<float> v, float p) {
+    if (v.empty()) return 0.0f;
+    size_t k = (size_t)std::clamp(p * (float)(v.size() - 1), 0.0f, (float)(v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+static float mean(const std::vector<float>& v) {
+    if (v.empty()) return 0.0f;
+    double s = 0.0;
+    for (float x : v) s += x;
+    return (float)(s / (double)v.size());
+}
+
+static float maxOf(const std::vector<float>& v) {
+    return v.empty() ? 0.0f : *std::max_element(v.begin(), v.end());
+}
+
+int main(int argc, char** argv) {
+    BatchConfig cfg;
+    if (!parseArgs(argc, argv, cfg)) {
+        printUsage();
+        return 1;
+    }
+
+    WorkerPool pool(cfg.threads);
+    std::vector<MissionResult> results((size_t)cfg.missions);
+
+    if (!cfg.tracePath.empty()) {
+        Trace::setThreadName("main");
+        Trace::start();
+    }
+
+    std::mutex statsMutex;
+    ChunkedTerrain::Stats chunkStats;
+
+    auto t0 = std::chrono::steady_clock::now();
+    pool.parallelFor(cfg.missions, 1, [&](int begin, int end) {
+        Simulation sim; // одна на кусок: буферы радара и рельефа переиспользуются
+        sim.unboundedTerrain = cfg.unbounded;
+        sim.terrainPrefetch = false;   // куски по промаху, на потоках пакета
+        ChunkedTerrain::Stats local;
+        for (int i = begin; i < end; ++i) {
+            results[i] = runMission(cfg, i, sim);
+            // reset следующей миссии сбрасывает кэш вместе со счётчиками
+            if (const ChunkedTerrain* world = sim.chunkedTerrain()) {
+                ChunkedTerrain::Stats st = world->stats();
+                local.hits += st.hits;
+                local.misses += st.misses;
+                local.prefetched += st.prefetched;
+            }
+        }
+        std::lock_guard<std::mutex> lock(statsMutex);
+        chunkStats.hits += local.hits;
+        chunkStats.misses += local.misses;
+        chunkStats.prefetched += local.prefetched;
+    });
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    if (!cfg.tracePath.empty()) {
+        Trace::stop();
+        if (!Trace::writeJson(cfg.tracePath)) {
+            std::fprintf(stderr, "cannot write %s\n", cfg.tracePath.c_str());
+            return 1;
+        }
+    }
+
+    int landed = 0, crashed = 0, timeout = 0;
+    long long steps = 0;
+    std::vector<float> fuel, tdVx, tdVy;
+    fuel.reserve(results.size());
+    for (const auto& r : results) {
+        steps += r.steps;
+        fuel.push_back(r.fuelUsed);
+        if (r.outcome == Outcome::Landed) ++landed;
+        else if (r.outcome == Outcome::Crashed) ++crashed;
+        else ++timeout;
+
+        if (r.outcome != Outcome::Timeout) {
+            tdVx.push_back(std::abs(r.touchdownVx));
+            tdVy.push_back(std::abs(r.touchdownVy));
+        }
+    }
+
+    const double n = (double)cfg.missions;
+    std::printf("missions      %d (seeds %d..%d), threads %d\n",
+                cfg.missions, cfg.seed, cfg.seed + cfg.missions - 1, pool.size());
+    std::printf("landed        %d (%.1f%%)\n", landed, 100.0 * landed / n);
+    std::printf("crashed       %d (%.1f%%)\n", crashed, 100.0 * crashed / n);
+    std::printf("timeout       %d (%.1f%%)\n", timeout, 100.0 * timeout / n);
+    std::printf("fuel used     mean %.1f  p50 %.1f  p95 %.1f\n",
+                mean(fuel), percentile(fuel, 0.5f), percentile(fuel, 0.95f));
+    std::printf("touchdown |vy| mean %.2f  p95 %.2f  max %.2f\n",
+                mean(tdVy), percentile(tdVy, 0.95f), maxOf(tdVy));
+    std::printf("touchdown |vx| mean %.2f  p95 %.2f  max %.2f\n",
+                mean(tdVx), percentile(tdVx, 0.95f), maxOf(tdVx));
+    std::printf("wall          %.2f s, %.1f missions/s, %.0f steps/s\n",
+                wall, n / wall, (double)steps / wall);
+    if (cfg.unbounded) {
+        std::printf("terrain chunks hits %llu  misses %llu  prefetched %llu\n",
+                    (unsigned long long)chunkStats.hits, (unsigned long long)chunkStats.misses,
+                    (unsigned long long)chunkStats.prefetched);
+    }
+
+    if (!cfg.csvPath.empty()) {
+        FILE* f = std::fopen(cfg.csvPath.c_str(), "w");
+        if (!f) {
+            std::fprintf(stderr, "cannot write %s\n", cfg.csvPath.c_str());
+            return 1;
+        }
+        static const char* names[] = {"landed", "crashed", "timeout"};
+        std::fprintf(f, "seed,start_x,outcome,steps,fuel_used,touchdown_vx,touchdown_vy\n");
+        for (const auto& r : results) {
+            std::fprintf(f, "%d,%.2f,%s,%d,%.3f,%.3f,%.3f\n", r.seed, r.startX,
+                         names[(int)r.outcome], r.steps, r.fuelUsed, r.touchdownVx, r.touchdownVy);
+        }
+        std::fclose(f);
+    }
+    return 0;
+}
@@ -1,15 +1,33 @@
 #include "Config.h"
-#include "TerrainGenerator.h"
-#include "PhysicsEngine.h"
-#include "LandingController.h"
-#include "RadarTypes.h"
-#include "LandingSiteDetector.h"
+#include "Profiler.h"
+#include "Trace.h"
+#include "SimThread.h"
 #include "Visualizer.h"
 #include <SFML/Graphics.hpp>
-#include <vector>
-#include <ctime>
 #include <algorithm>
-#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+// Клавиши, которые держат, а не нажимают: опрашиваются каждый кадр
+static std::uint32_t pollHeldKeys() {
+    using sf::Keyboard::isKeyPressed;
+    using Key = sf::Keyboard::Key;
+    std::uint32_t keys = 0;
+    if (isKeyPressed(Key::Up))    keys |= HeldKey::MainThrust;
+    if (isKeyPressed(Key::Left))  keys |= HeldKey::LeftThrust;
+    if (isKeyPressed(Key::Right)) keys |= HeldKey::RightThrust;
+    if (isKeyPressed(Key::W))     keys |= HeldKey::GimbalUp;
+    if (isKeyPressed(Key::S))     keys |= HeldKey::GimbalDown;
+    if (isKeyPressed(Key::Q))     keys |= HeldKey::GimbalQ;
+    if (isKeyPressed(Key::E))     keys |= HeldKey::GimbalE;
+    if (isKeyPressed(Key::U))     keys |= HeldKey::WindUp;
+    if (isKeyPressed(Key::J))     keys |= HeldKey::WindDown;
+    if (isKeyPressed(Key::H))     keys |= HeldKey::WindLeft;
+    if (isKeyPressed(Key::K))     keys |= HeldKey::WindRight;
+    return keys;
+}
 
 int main() {
     std::srand(static_cast<unsigned int>(std::time(nullptr)));
@@ -21,221 +39,124 @@ int main() {
     bool zoomed = false;
     zoomView.zoom(0.5f);
 
-    TerrainGenerator terrainGen;
-    PhysicsEngine physics;
-    LandingController autopilot;
     Visualizer visualizer;
-
-    std::vector<float> terrain;
-    bool autoMode = true;
-    bool paused = true;
-
-    float timeScale = 1.0f;
-    float timeAcc = 0.0f;
-    int gimbalMode = 3;       // 1=левый,2=правый,3=оба
-
-    float leftGimbal = 0.0f;
-    float rightGimbal = 0.0f;
-    bool landingFoundShown = false;
-    float foundMsgTimer = 0.0f;
-
-    sf::Vector2f wind{0.0f, 0.0f};
-
-    RadarConfig radarCfg;
-    DetectorConfig detCfg;
-    detCfg.maxSlope = std::tan(Config::MAX_LANDING_ANGLE_RAD);
-    detCfg.maxBandY = std::max(detCfg.maxBandY, detCfg.maxSlope * detCfg.minLenX);
-
-    auto restartMission = [&]() {
-        landingFoundShown = false;
-        foundMsgTimer = 0.0f;
-        autopilot.reset();
-        timeAcc = 0.0f;
-
-        wind = {0.0f, 0.0f};
-        physics.setWind(wind);
-
-        int seed = std::rand();
-        
-        terrain = terrainGen.generate(Config::WINDOW_WIDTH, seed);
-        float startX = 100.0f + (std::rand() % (Config::WINDOW_WIDTH - 200));
-        
-        physics.init(startX, 50.0f, 500.0f, {100.0f, 100.0f});
-    };
-
-    restartMission();
-    
-    while (window.isOpen()) {
-        while (const std::optional event = window.pollEvent()) {
-            if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
-                if (keyPressed->code == sf::Keyboard::Key::P) paused = !paused;
-                if (keyPressed->code == sf::Keyboard::Key::R) restartMission();
-                if (keyPressed->code == sf::Keyboard::Key::M) autoMode = !autoMode;
-                if (keyPressed->code == sf::Keyboard::Key::Num0 ||
-                    keyPressed->code == sf::Keyboard::Key::Numpad0)
-                {
-                    wind = {0.0f, 0.0f};
-                }
-
-                if (keyPressed->code == sf::Keyboard::Key::Hyphen) {
-                    timeScale = std::max(0.25f, timeScale * 0.5f);
-                }
-                if (keyPressed->code == sf::Keyboard::Key::Equal) {
-                    timeScale = std::min(4.0f, timeScale * 2.0f);
+    Trace::setThreadName("render");
+    const char* tracePath = "marslander_trace.json";
+
+    // физика, радар и автопилот — в своём потоке; окно только рисует снимки
+    SimThread sim;
+    sim.start();
+
+    bool redraw = true;     // вид поменялся — кадр нужен и без нового снимка
+    unsigned shownTerrain = 0;
+    ProfileReport profReport;           // пересчитывается несколько раз в секунду, чтобы цифры читались
+    sf::Clock profClock;
+    sf::Clock sinceInput;   // недавний ввод: ответ потока симуляции ждём без долгого сна
+
+    auto handleEvent = [&](const sf::Event& event) {
+        sinceInput.restart();
+        if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+            switch (keyPressed->code) {
+            case sf::Keyboard::Key::P:       sim.send(SimCommand::TogglePause); break;
+            case sf::Keyboard::Key::R:       sim.send(SimCommand::Restart); break;
+            case sf::Keyboard::Key::M:       sim.send(SimCommand::ToggleAuto); break;
+            case sf::Keyboard::Key::Num0:
+            case sf::Keyboard::Key::Numpad0: sim.send(SimCommand::ResetWind); break;
+            case sf::Keyboard::Key::Hyphen:  sim.send(SimCommand::SlowDown); break;
+            case sf::Keyboard::Key::Equal:   sim.send(SimCommand::SpeedUp); break;
+            case sf::Keyboard::Key::X:       sim.send(SimCommand::SwapGimbals); break;
+            case sf::Keyboard::Key::Z:       sim.send(SimCommand::ZeroGimbals); break;
+            case sf::Keyboard::Key::Num1:    sim.send(SimCommand::GimbalLeft); break;
+            case sf::Keyboard::Key::Num2:    sim.send(SimCommand::GimbalRight); break;
+            case sf::Keyboard::Key::Num3:    sim.send(SimCommand::GimbalBoth); break;
+            case sf::Keyboard::Key::T:       sim.send(SimCommand::ToggleTurbo); break;
+            case sf::Keyboard::Key::I:       sim.send(SimCommand::ToggleUnbounded); break;
+            case sf::Keyboard::Key::F3:
+                Profiler::setEnabled(!Profiler::enabled());
+                redraw = true;
+                break;
+            case sf::Keyboard::Key::F4:
+                // первое нажатие начинает трассу, второе сохраняет её
+                if (!Trace::enabled()) {
+                    Trace::start();
+                } else {
+                    Trace::stop();
+                    if (Trace::writeJson(tracePath)) std::printf("trace written to %s\n", tracePath);
+                    else std::fprintf(stderr, "cannot write %s\n", tracePath);
                 }
-
-                if (keyPressed->code == sf::Keyboard::Key::X) {
-                    std::swap(leftGimbal, rightGimbal);
-                }
-
-                if (keyPressed->code == sf::Keyboard::Key::Z) {
-                    leftGimbal = 0.0f;
-                    rightGimbal = 0.0f;
-                }
-                if (keyPressed->code == sf::Keyboard::Key::Num1) gimbalMode = 1;
-                if (keyPressed->code == sf::Keyboard::Key::Num2) gimbalMode = 2;
-                if (keyPressed->code == sf::Keyboard::Key::Num3) gimbalMode = 3;
+                break;
+            default: break;
             }
-            if (const auto mb = event->getIf<sf::Event::MouseButtonPressed>()) {
-                if (mb->button == sf::Mouse::Button::Left) {
-                    if (!zoomed) {
-                        sf::Vector2i pixelPos(mb->position.x, mb->position.y);
-                        sf::Vector2f worldPos = window.mapPixelToCoords(pixelPos, defaultView);
-                        float viewHalfW = Config::WINDOW_WIDTH * 0.25f;
-                        float viewHalfH = Config::WINDOW_HEIGHT * 0.25f;
-                        float clampedX = std::clamp(worldPos.x, viewHalfW, (float)Config::WINDOW_WIDTH - viewHalfW);
-                        float clampedY = std::clamp(worldPos.y, viewHalfH, (float)Config::WINDOW_HEIGHT - viewHalfH);
-                        zoomView.setCenter({clampedX, clampedY});
-                        window.setView(zoomView);
-                        zoomed = true;
-                    } else {
-                        window.setView(defaultView);
-                        zoomed = false;
-                    }
-                }
-            }
-            if (event->is<sf::Event::Closed>()) window.close();
         }
-
-        {
-            const float windRate = Config::WIND_RATE;
-            const float windMax = Config::WIND_MAX;
-            sf::Vector2f dv{0.0f, 0.0f};
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::U)) dv.y -= windRate * Config::DT;
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::J)) dv.y += windRate * Config::DT;
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::H)) dv.x -= windRate * Config::DT;
-            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::K)) dv.x += windRate * Config::DT;
-
-            wind += dv;
-            float L = std::sqrt(wind.x * wind.x + wind.y * wind.y);
-            if (L > windMax && L > 1e-6f) {
-                wind.x = wind.x / L * windMax;
-                wind.y = wind.y / L * windMax;
+        if (const auto mb = event.getIf<sf::Event::MouseButtonPressed>()) {
+            if (mb->button == sf::Mouse::Button::Left) {
+                if (!zoomed) {
+                    sf::Vector2i pixelPos(mb->position.x, mb->position.y);
+                    sf::Vector2f worldPos = window.mapPixelToCoords(pixelPos, defaultView);
+                    float viewHalfW = Config::WINDOW_WIDTH * 0.25f;
+                    float viewHalfH = Config::WINDOW_HEIGHT * 0.25f;
+                    float clampedX = std::clamp(worldPos.x, viewHalfW, (float)Config::WINDOW_WIDTH - viewHalfW);
+                    float clampedY = std::clamp(worldPos.y, viewHalfH, (float)Config::WINDOW_HEIGHT - viewHalfH);
+                    zoomView.setCenter({clampedX, clampedY});
+                    window.setView(zoomView);
+                    redraw = true;
+                    zoomed = true;
+                } else {
+                    window.setView(defaultView);
+                    redraw = true;
+                    zoomed = false;
+                }
             }
         }
+        if (event.is<sf::Event::Closed>()) window.close();
+        if (event.is<sf::Event::FocusGained>() || event.is<sf::Event::Resized>()) redraw = true;
+    };
 
-        RoverState state = physics.getState();
-        std::vector<RayHit> radarHits;
-        bool hasTargetSite = autopilot.hasLandingTarget();
-        LandingSite targetSite{};
-        if (hasTargetSite) targetSite = autopilot.getLandingTarget();
-
-        auto doOneSimStep = [&]() {
-
-            physics.setWind(wind);
-
-
-            RoverState st = physics.getState();
-            int tIdx = std::clamp((int)st.x, 0, Config::WINDOW_WIDTH - 1);
-            float terrainH = terrain[tIdx];
-
-
-            Vec2 radarOrigin{st.x, st.y};
-            radarHits = scanRadar(terrain, radarOrigin, st.angle, radarCfg);
-
-            auto sites = detectLandingSites(radarHits, st.x, detCfg);
-            LandingSite bestSite{};
-            bool hasBestSite = pickBestSite(sites, bestSite);
-
-            if (hasBestSite && !autopilot.hasLandingTarget()) {
-                autopilot.setLandingTarget(bestSite);
-            }
-
-            hasTargetSite = autopilot.hasLandingTarget();
-            if (hasTargetSite) targetSite = autopilot.getLandingTarget();
-
-
-            if (foundMsgTimer > 0.0f) foundMsgTimer -= Config::DT;
-            if (!landingFoundShown && autoMode && hasTargetSite) {
-                landingFoundShown = true;
-                foundMsgTimer = 5.0f;
-            }
-
-            ControlOutput ctrl{};
-            if (autoMode) {
-                ctrl = autopilot.compute(st, radarHits);
-            } else {
-                ctrl.mainThrust = 0.0f;
-                ctrl.leftThrust = 0.0f;
-                ctrl.rightThrust = 0.0f;
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Up))    ctrl.mainThrust = 1.0f;
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right)) ctrl.rightThrust = 1.0f;
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left))  ctrl.leftThrust = 1.0f;
-
-                const float gimbalSpeed = 2.5f;
-                const float maxGimbal   = 0.8f;
-
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W)) {
-                    leftGimbal  += gimbalSpeed * Config::DT;
-                    rightGimbal += gimbalSpeed * Config::DT;
-                }
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S)) {
-                    leftGimbal  -= gimbalSpeed * Config::DT;
-                    rightGimbal -= gimbalSpeed * Config::DT;
-                }
-
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Q)) {
-                    if (gimbalMode == 1) leftGimbal -= gimbalSpeed * Config::DT;
-                    else if (gimbalMode == 2) rightGimbal -= gimbalSpeed * Config::DT;
-                    else { leftGimbal -= gimbalSpeed * Config::DT; rightGimbal += gimbalSpeed * Config::DT; }
-                }
-                if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::E)) {
-                    if (gimbalMode == 1) leftGimbal += gimbalSpeed * Config::DT;
-                    else if (gimbalMode == 2) rightGimbal += gimbalSpeed * Config::DT;
-                    else { leftGimbal += gimbalSpeed * Config::DT; rightGimbal -= gimbalSpeed * Config::DT; }
-                }
+    while (window.isOpen()) {
+        while (const std::optional event = window.pollEvent()) handleEvent(*event);
 
-                leftGimbal  = std::clamp(leftGimbal,  -maxGimbal, maxGimbal);
-                rightGimbal = std::clamp(rightGimbal, -maxGimbal, maxGimbal);
-                ctrl.leftGimbal  = leftGimbal;
-                ctrl.rightGimbal = rightGimbal;
-            }
+        sim.setHeldKeys(pollHeldKeys());
 
-            physics.update(ctrl, terrainH);
+        bool fresh = sim.refresh();
+        const SimSnapshot& snap = sim.snapshot();
 
-            state = physics.getState();
-        };
+        // Кадр без нового снимка совпал бы с прошлым: ждём события. Поток
+        // симуляции публикует, только когда что-то поменялось, так что на паузе
+        // окно спит, а в турбо рисует с частотой публикации.
+        if (!fresh && !redraw) {
+            bool idle = snap.paused && sinceInput.getElapsedTime() > sf::milliseconds(250);
+            if (const std::optional event = window.waitEvent(idle ? sf::milliseconds(250) : sf::milliseconds(2)))
+                handleEvent(*event);
+            continue;
+        }
+        redraw = false;
 
-        if (!paused) {
-            timeAcc += timeScale;
-            while (timeAcc >= 1.0f) {
-                doOneSimStep();
-                timeAcc -= 1.0f;
-            }
-        } else {
-            Vec2 radarOrigin{state.x, state.y};
-            radarHits = scanRadar(terrain, radarOrigin, 0.0f, radarCfg);
-            hasTargetSite = autopilot.hasLandingTarget();
-            if (hasTargetSite) targetSite = autopilot.getLandingTarget();
+        if (snap.terrainVersion != shownTerrain) {
+            visualizer.setTerrain(snap.terrain, snap.terrainOrigin);
+            shownTerrain = snap.terrainVersion;
         }
+        // в мире без краёв корабль всегда посередине экрана
+        visualizer.setCameraX(snap.unbounded ? snap.state.x - Config::WINDOW_WIDTH * 0.5f : 0.0f);
 
+        ProfileScope frameProbe(ProfileStage::Frame);
         window.clear();
-        visualizer.draw(window, state, terrain, radarHits, hasTargetSite, targetSite,
-                        autoMode, paused, foundMsgTimer, wind,
-                        timeScale, gimbalMode, autopilot.getPhaseName());
-        
+        visualizer.draw(window, snap.state, snap.radarHits,
+                        snap.hasTargetSite, snap.targetSite,
+                        snap.autoMode, snap.paused, snap.foundMsgTimer, {snap.wind.x, snap.wind.y},
+                        snap.timeScale, snap.turbo, snap.stepsPerSecond,
+                        snap.gimbalMode, snap.phaseName);
+
+        if (Profiler::enabled()) {
+            if (profClock.getElapsedTime() > sf::milliseconds(250)) {
+                profReport = Profiler::report();
+                profClock.restart();
+            }
+            visualizer.drawProfiler(window, profReport);
+        }
 
         window.display();
     }
+
+    sim.stop();
     return 0;
 }
@@ -0,0 +1,195 @@
+#include "marslander.h"
+#include "Simulation.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <atomic>
+
+struct ml_sim {
+    Simulation sim;
+};
+
+// Исключения не должны пересекать C-границу
+template <typename Fn>
+static int guarded(Fn&& fn) {
+    try {
+        return fn();
+    } catch (...) {
+        return ML_ERR_INTERNAL;
+    }
+}
+
+static bool validSims(ml_sim* const* sims, int n) {
+    if (n < 0 || (n > 0 && !sims)) return false;
+    for (int i = 0; i < n; ++i) if (!sims[i]) return false;
+    return true;
+}
+
+// fn(i) для всех симуляций на общем пуле. Исключение ловится внутри куска,
+// чтобы не бросить соседние симуляции недошагнутыми; status[i] — код каждой
+template <typename Fn>
+static int forEachSim(int n, int minChunk, int32_t* status, Fn&& fn) {
+    std::atomic<bool> failed{false};
+    int rc = guarded([&] {
+        WorkerPool::shared().parallelFor(n, minChunk, [&](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                int r = guarded([&] { return fn(i); });
+                if (status) status[i] = r;
+                if (r < 0) failed.store(true, std::memory_order_relaxed);
+            }
+        });
+        return ML_OK;
+    });
+    return rc != ML_OK || failed.load() ? ML_ERR_INTERNAL : ML_OK;
+}
+
+static int scanInto(Simulation& sim, float angle,
+                    float* out_t, float* out_px, float* out_py, uint8_t* out_hit,
+                    int capacity)
+{
+    sim.scanRadarAt(angle);
+    const RadarHitBuffer& hits = sim.getRadarHits();
+    int n = std::min(hits.size(), std::max(0, capacity));
+    if (out_t) std::copy(hits.t.begin(), hits.t.begin() + n, out_t);
+    if (out_px) std::copy(hits.px.begin(), hits.px.begin() + n, out_px);
+    if (out_py) std::copy(hits.py.begin(), hits.py.begin() + n, out_py);
+    if (out_hit) std::copy(hits.hit.begin(), hits.hit.begin() + n, out_hit);
+    return hits.size();
+}
+
+static void fillState(const Simulation& sim, ml_state* out) {
+    const RoverState& s = sim.getState();
+    out->x = s.x; out->y = s.y;
+    out->vx = s.vx; out->vy = s.vy;
+    out->angle = s.angle;
+    out->angular_vel = s.angularVel;
+    out->fuel_main = s.fuelMain;
+    float aux = 0.0f;
+    for (float t : s.auxTanks) aux += t;
+    out->fuel_aux = aux;
+    out->touchdown_vx = s.touchdownVx;
+    out->touchdown_vy = s.touchdownVy;
+    out->landed = s.landed ? 1 : 0;
+    out->crashed = s.crashed ? 1 : 0;
+    out->steps = sim.stepCount();
+}
+
+static ControlOutput toControl(const ml_control& c) {
+    return {c.main_thrust, c.left_thrust, c.right_thrust, c.left_gimbal, c.right_gimbal};
+}
+
+int ml_abi_version(void) {
+    return ML_ABI_VERSION;
+}
+
+ml_sim* ml_create(int seed, float start_x) {
+    try {
+        ml_sim* sim = new ml_sim();
+        sim->sim.reset(seed, start_x);
+        return sim;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void ml_destroy(ml_sim* sim) {
+    delete sim;
+}
+
+int ml_reset(ml_sim* sim, int seed, float start_x) {
+    if (!sim) return ML_ERR_ARG;
+    return guarded([&] { sim->sim.reset(seed, start_x); return ML_OK; });
+}
+
+int ml_set_wind(ml_sim* sim, float wind_x, float wind_y) {
+    if (!sim) return ML_ERR_ARG;
+    sim->sim.setWind({wind_x, wind_y});
+    return ML_OK;
+}
+
+int ml_step(ml_sim* sim, const ml_control* control) {
+    if (!sim) return ML_ERR_ARG;
+    return guarded([&] {
+        if (control) sim->sim.step(toControl(*control));
+        else sim->sim.step();
+        return ML_OK;
+    });
+}
+
+int ml_get_state(const ml_sim* sim, ml_state* out) {
+    if (!sim || !out) return ML_ERR_ARG;
+    fillState(sim->sim, out);
+    return ML_OK;
+}
+
+int ml_get_terrain(const ml_sim* sim, float* out, int capacity) {
+    if (!sim || (capacity > 0 && !out)) return ML_ERR_ARG;
+    const std::vector<float>& terrain = sim->sim.getTerrain();
+    int n = std::min((int)terrain.size(), std::max(0, capacity));
+    std::copy(terrain.begin(), terrain.begin() + n, out);
+    return (int)terrain.size();
+}
+
+int ml_get_landing_target(const ml_sim* sim, float* center_x, float* y_mean) {
+    if (!sim) return ML_ERR_ARG;
+    if (!sim->sim.hasLandingTarget()) return 0;
+    const LandingSite& site = sim->sim.getLandingTarget();
+    if (center_x) *center_x = site.centerX;
+    if (y_mean) *y_mean = site.yMean;
+    return 1;
+}
+
+int ml_radar_scan(ml_sim* sim, float angle,
+                  float* out_t, float* out_px, float* out_py, uint8_t* out_hit,
+                  int capacity)
+{
+    if (!sim) return ML_ERR_ARG;
+    return guarded([&] {
+        return scanInto(sim->sim, angle, out_t, out_px, out_py, out_hit, capacity);
+    });
+}
+
+int ml_reset_many(ml_sim* const* sims, int n, const int32_t* seeds, const float* start_x,
+                  int32_t* status)
+{
+    if (!validSims(sims, n) || (n > 0 && (!seeds || !start_x))) return ML_ERR_ARG;
+    return forEachSim(n, 1, status, [&](int i) {
+        sims[i]->sim.reset(seeds[i], start_x[i]);
+        return ML_OK;
+    });
+}
+
+int ml_step_many(ml_sim* const* sims, int n, const ml_control* controls, int32_t* status) {
+    if (!validSims(sims, n)) return ML_ERR_ARG;
+    return forEachSim(n, 4, status, [&](int i) {
+        if (controls) sims[i]->sim.step(toControl(controls[i]));
+        else sims[i]->sim.step();
+        return ML_OK;
+    });
+}
+
+int ml_radar_scan_many(ml_sim* const* sims, int n, const float* angles,
+                       float* out_t, float* out_px, float* out_py, uint8_t* out_hit,
+                       int capacity, int32_t* status)
+{
+    if (!validSims(sims, n) || (n > 0 && !angles)) return ML_ERR_ARG;
+    const size_t stride = (size_t)std::max(0, capacity);
+    return forEachSim(n, 4, status, [&](int i) {
+        const size_t off = (size_t)i * stride;
+        return scanInto(sims[i]->sim, angles[i],
+                        out_t ? out_t + off : nullptr, out_px ? out_px + off : nullptr,
+                        out_py ? out_py + off : nullptr, out_hit ? out_hit + off : nullptr,
+                        capacity);
+    });
+}
+
+int ml_get_state_many(ml_sim* const* sims, int n, ml_state* out) {
+    if (!validSims(sims, n) || (n > 0 && !out)) return ML_ERR_ARG;
+    for (int i = 0; i < n; ++i) fillState(sims[i]->sim, out + i);
+    return ML_OK;
+}
+
+int ml_set_wind_many(ml_sim* const* sims, int n, const float* wind_xy) {
+    if (!validSims(sims, n) || (n > 0 && !wind_xy)) return ML_ERR_ARG;
+    for (int i = 0; i < n; ++i) sims[i]->sim.setWind({wind_xy[2 * i], wind_xy[2 * i + 1]});
+    return ML_OK;
+}